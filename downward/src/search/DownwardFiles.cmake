@@ -116,6 +116,7 @@ fast_downward_plugin(
         utils/markup
         utils/math
         utils/memory
+        utils/parallel
         utils/rng
         utils/rng_options
         utils/strings
@@ -168,6 +169,14 @@ fast_downward_plugin(
         open_lists/type_based_open_list
 )
 
+fast_downward_plugin(
+    NAME TRACE_OPEN_LIST
+    HELP "Open list that records its operations for the open list replay benchmark"
+    SOURCES
+        open_lists/open_list_trace
+        open_lists/trace_open_list
+)
+
 fast_downward_plugin(
     NAME DYNAMIC_BITSET
     HELP "Poor man's version of boost::dynamic_bitset"
@@ -236,6 +245,7 @@ fast_downward_plugin(
     NAME SEGMENTED_VECTOR
     HELP "Memory-friendly and vector-like data structure"
     SOURCES
+        algorithms/mapped_segment_pool
         algorithms/segmented_vector
     DEPENDENCY_ONLY
 )
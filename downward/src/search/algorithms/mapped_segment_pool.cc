@@ -0,0 +1,111 @@
+#include "mapped_segment_pool.h"
+
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using utils::ExitCode;
+
+namespace segmented_vector {
+const size_t MappedSegmentPool::CHUNK_BYTES;
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+// Segments are aligned to cache lines.
+static const size_t ALIGNMENT = 64;
+
+static size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+static void exit_with_system_error(const string &message) {
+    cerr << message << ": " << strerror(errno) << endl;
+    utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+MappedSegmentPool::MappedSegmentPool(
+    const string &directory, size_t max_resident_bytes)
+    : file_descriptor(-1),
+      file_size(0),
+      max_resident_chunks(max<size_t>(max_resident_bytes / CHUNK_BYTES, 1)),
+      used_bytes_in_last_chunk(0) {
+    string path_template = directory + "/downward-segments-XXXXXX";
+    vector<char> path(path_template.begin(), path_template.end());
+    path.push_back('\0');
+    file_descriptor = mkstemp(path.data());
+    if (file_descriptor == -1)
+        exit_with_system_error("could not create segment file in " + directory);
+    // Remove the name right away, so the file is deleted when we exit.
+    unlink(path.data());
+}
+
+MappedSegmentPool::~MappedSegmentPool() {
+    for (const Chunk &chunk : chunks) {
+        munmap(chunk.data, chunk.size);
+    }
+    close(file_descriptor);
+}
+
+void MappedSegmentPool::add_chunk(size_t min_bytes) {
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t chunk_size = round_up(max(min_bytes, CHUNK_BYTES), page_size);
+    if (ftruncate(file_descriptor, file_size + chunk_size) == -1)
+        exit_with_system_error("could not grow segment file");
+    void *data = mmap(nullptr, chunk_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, file_descriptor, file_size);
+    if (data == MAP_FAILED)
+        exit_with_system_error("could not map segment file");
+    madvise(data, chunk_size, MADV_RANDOM);
+    file_size += chunk_size;
+    chunks.push_back({static_cast<char *>(data), chunk_size});
+    used_bytes_in_last_chunk = 0;
+
+#ifdef MADV_COLD
+    if (chunks.size() > max_resident_chunks) {
+        const Chunk &cold_chunk = chunks[chunks.size() - max_resident_chunks - 1];
+        madvise(cold_chunk.data, cold_chunk.size, MADV_COLD);
+    }
+#endif
+}
+
+void *MappedSegmentPool::allocate(size_t bytes) {
+    bytes = round_up(bytes, ALIGNMENT);
+    if (chunks.empty() ||
+        used_bytes_in_last_chunk + bytes > chunks.back().size) {
+        add_chunk(bytes);
+    }
+    void *result = chunks.back().data + used_bytes_in_last_chunk;
+    used_bytes_in_last_chunk += bytes;
+    return result;
+}
+#else
+MappedSegmentPool::MappedSegmentPool(const string &, size_t)
+    : file_descriptor(-1),
+      file_size(0),
+      max_resident_chunks(0),
+      used_bytes_in_last_chunk(0) {
+    cerr << "Storing segments in files is not supported on this "
+         << "operating system." << endl;
+    utils::exit_with(ExitCode::SEARCH_UNSUPPORTED);
+}
+
+MappedSegmentPool::~MappedSegmentPool() {
+}
+
+void MappedSegmentPool::add_chunk(size_t) {
+}
+
+void *MappedSegmentPool::allocate(size_t) {
+    return nullptr;
+}
+#endif
+}
@@ -0,0 +1,128 @@
+#ifndef ALGORITHMS_MAPPED_SEGMENT_POOL_H
+#define ALGORITHMS_MAPPED_SEGMENT_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+/*
+  MappedSegmentPool provides the memory for the segments of
+  SegmentedVector and SegmentedArrayVector from an anonymous temporary
+  file, which lets searches store more states than fit into physical
+  memory. The file is created in a given directory (which should be on a
+  local disk) and unlinked immediately, so it disappears when the
+  planner exits.
+
+  The file is mapped in chunks of CHUNK_BYTES (or more for huge
+  segments), and segments are allocated from the chunks in a bump-pointer
+  fashion. Since the segmented vectors never free segments before they
+  are destroyed, segments are never returned to the pool: all memory is
+  released when the pool is destroyed.
+
+  Whether a page is in memory is left to the kernel, which evicts pages
+  of file mappings in LRU order. We help it with two hints: chunks are
+  marked as randomly accessed (MADV_RANDOM), since state IDs are looked
+  up in no particular order, and whenever a chunk is added, all but the
+  most recent max_resident_chunks chunks are marked as cold (MADV_COLD,
+  where available). Segments are appended in order of state IDs, so
+  this keeps the states generated most recently, which are the ones
+  usually accessed next, in memory.
+
+  Note that the mapped chunks count towards the address space of the
+  process, so this does not help with limits on virtual memory (ulimit
+  -v), only with limits on physical memory.
+*/
+
+namespace segmented_vector {
+class MappedSegmentPool {
+    static const size_t CHUNK_BYTES = 64 * 1024 * 1024;
+
+    struct Chunk {
+        char *data;
+        size_t size;
+    };
+
+    int file_descriptor;
+    size_t file_size;
+    const size_t max_resident_chunks;
+    std::vector<Chunk> chunks;
+    size_t used_bytes_in_last_chunk;
+
+    void add_chunk(size_t min_bytes);
+public:
+    MappedSegmentPool(const std::string &directory, size_t max_resident_bytes);
+    ~MappedSegmentPool();
+
+    MappedSegmentPool(const MappedSegmentPool &) = delete;
+    MappedSegmentPool &operator=(const MappedSegmentPool &) = delete;
+
+    void *allocate(size_t bytes);
+
+    size_t get_file_size() const {
+        return file_size;
+    }
+};
+
+
+/*
+  Allocator for segmented vectors that allocates from a
+  MappedSegmentPool if one is given and from the heap otherwise. Like
+  the pool, it only supports the subset of the allocator interface
+  needed by the segmented vectors.
+*/
+template<class T>
+class SegmentAllocator {
+    template<class U>
+    friend class SegmentAllocator;
+
+    std::shared_ptr<MappedSegmentPool> pool;
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<class U>
+    struct rebind {
+        using other = SegmentAllocator<U>;
+    };
+
+    SegmentAllocator() = default;
+
+    explicit SegmentAllocator(const std::shared_ptr<MappedSegmentPool> &pool)
+        : pool(pool) {
+    }
+
+    template<class U>
+    SegmentAllocator(const SegmentAllocator<U> &other)
+        : pool(other.pool) {
+    }
+
+    T *allocate(size_t n) {
+        if (pool)
+            return static_cast<T *>(pool->allocate(n * sizeof(T)));
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t) {
+        // Memory from the pool is released together with the pool.
+        if (!pool)
+            ::operator delete(p);
+    }
+
+    void construct(T *p, const T &value) {
+        ::new(static_cast<void *>(p))T(value);
+    }
+
+    void destroy(T *p) {
+        p->~T();
+    }
+};
+}
+
+#endif
@@ -0,0 +1,216 @@
+/*
+  Replay an open list trace on a given open list.
+
+  Traces are recorded with the "trace" open list during a regular
+  search, e.g.
+
+    --search "eager(trace(single(ff()), evals=[ff()], trace_file=ff.trace))"
+
+  and contain every insertion (with the recorded evaluator values, the g
+  value and the preferredness of the entry), removal, boost and clear
+  operation the search performed on the open list. Replaying the trace
+  on another open list therefore exercises the open list with the
+  workload of a real search, without computing any heuristics or
+  generating any states. Since removals do not feed back into the
+  replayed insertions, the replayed open list should be compatible with
+  the recorded one (e.g., same entry type); otherwise the timings are
+  still meaningful, but the sequence of operations is not one the
+  search would have performed.
+
+  The i-th recorded evaluator is available as "e<i>" in the open list
+  configuration. Path-dependent evaluators that only depend on the g
+  value, such as g(), can be used as well. Removals from an empty open
+  list are skipped and counted.
+*/
+
+#include "synthetic_graph.h"
+#include "synthetic_task.h"
+
+#include "../evaluation_context.h"
+#include "../evaluation_result.h"
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+#include "../option_parser.h"
+#include "../state_registry.h"
+#include "../task_proxy.h"
+
+#include "../open_lists/open_list_trace.h"
+#include "../options/predefinitions.h"
+#include "../options/registries.h"
+#include "../utils/system.h"
+#include "../utils/timer.h"
+
+#include <iostream>
+
+using namespace std;
+using namespace open_list_trace;
+
+/*
+  Evaluator that reports the i-th value of the key of the insertion
+  that is currently replayed.
+*/
+class ReplayEvaluator : public Evaluator {
+    const int *const &current_key;
+    const int index;
+public:
+    ReplayEvaluator(const int *const &current_key, int index,
+                    const string &description)
+        : Evaluator(description),
+          current_key(current_key),
+          index(index) {
+    }
+
+    virtual EvaluationResult compute_result(EvaluationContext &) override {
+        EvaluationResult result;
+        result.set_evaluator_value(current_key[index]);
+        return result;
+    }
+
+    virtual void get_path_dependent_evaluators(set<Evaluator *> &) override {}
+};
+
+struct ReplayStatistics {
+    long long num_insertions = 0;
+    long long num_removals = 0;
+    long long num_skipped_removals = 0;
+    long long num_boosts = 0;
+    long long num_clears = 0;
+};
+
+template<class Entry>
+static void replay(
+    const Trace &trace, OpenListFactory &factory, const State &state,
+    const int *&current_key, ReplayStatistics &statistics) {
+    unique_ptr<OpenList<Entry>> open_list = factory.create_open_list<Entry>();
+    for (const TraceRecord &record : trace.get_records()) {
+        switch (record.operation) {
+        case Operation::INSERT:
+        case Operation::INSERT_PREFERRED:
+        {
+            current_key = trace.get_key(record);
+            bool preferred = record.operation == Operation::INSERT_PREFERRED;
+            EvaluationContext eval_context(state, record.g, preferred, nullptr);
+            open_list->insert(eval_context, trace.get_entry<Entry>(record));
+            ++statistics.num_insertions;
+            break;
+        }
+        case Operation::REMOVE_MIN:
+            if (open_list->empty()) {
+                ++statistics.num_skipped_removals;
+            } else {
+                open_list->remove_min();
+                ++statistics.num_removals;
+            }
+            break;
+        case Operation::BOOST_PREFERRED:
+            open_list->boost_preferred();
+            ++statistics.num_boosts;
+            break;
+        case Operation::CLEAR:
+            open_list->clear();
+            ++statistics.num_clears;
+            break;
+        case Operation::END:
+            ABORT("The end of the trace is not stored as a record.");
+        }
+    }
+}
+
+static void print_usage(const char *program) {
+    cerr << "usage: " << program << " TRACE OPEN_LIST [--repeat N]" << endl
+         << "The recorded evaluators are available as e0, e1, ..." << endl;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3 && argc != 5) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    int num_repetitions = 1;
+    if (argc == 5) {
+        try {
+            num_repetitions = stoi(argv[4]);
+        } catch (const exception &) {
+            num_repetitions = 0;
+        }
+        if (string(argv[3]) != "--repeat" || num_repetitions < 1) {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    utils::Timer load_timer;
+    Trace trace(argv[1]);
+    const TraceHeader &header = trace.get_header();
+    cout << "Loaded " << trace.get_records().size() << " operations on "
+         << (header.entry_type == EntryType::STATE ? "state" : "edge")
+         << " open list in " << load_timer << endl;
+
+    const int *current_key = nullptr;
+    options::Predefinitions predefinitions;
+    for (int i = 0; i < trace.get_num_evaluators(); ++i) {
+        string name = "e" + to_string(i);
+        const string &description = header.evaluator_descriptions[i];
+        cout << name << ": " << description << endl;
+        predefinitions.predefine(
+            name, shared_ptr<Evaluator>(
+                make_shared<ReplayEvaluator>(current_key, i, description)));
+    }
+
+    options::Registry registry(*options::RawRegistry::instance());
+    shared_ptr<OpenListFactory> factory;
+    try {
+        OptionParser parser(argv[2], registry, predefinitions, false);
+        factory = parser.start_parsing<shared_ptr<OpenListFactory>>();
+    } catch (const utils::Exception &error) {
+        error.print();
+        return 2;
+    }
+
+    /*
+      Evaluation contexts need a state, but the replayed evaluators do
+      not look at it, so we use the initial state of a trivial task. (The
+      state packer cannot handle variables with a single value, so the
+      task needs two nodes.)
+    */
+    synthetic_graph::SyntheticGraph graph;
+    graph.successors.resize(2);
+    graph.initial_node = 0;
+    graph.goal_node = 1;
+    graph.goal_distances = {synthetic_graph::UNREACHABLE, 0};
+    synthetic_graph::SyntheticTask task(graph);
+    StateRegistry state_registry{TaskProxy(task)};
+    const State &state = state_registry.get_initial_state();
+
+    int peak_memory_before = utils::get_peak_memory_in_kb();
+    utils::Timer timer;
+    ReplayStatistics statistics;
+    for (int i = 0; i < num_repetitions; ++i) {
+        if (header.entry_type == EntryType::STATE)
+            replay<StateOpenListEntry>(
+                trace, *factory, state, current_key, statistics);
+        else
+            replay<EdgeOpenListEntry>(
+                trace, *factory, state, current_key, statistics);
+    }
+    timer.stop();
+
+    long long num_operations =
+        statistics.num_insertions + statistics.num_removals +
+        statistics.num_boosts + statistics.num_clears;
+    cout << "Repetitions: " << num_repetitions << endl
+         << "Insertions: " << statistics.num_insertions << endl
+         << "Removals: " << statistics.num_removals << endl
+         << "Skipped removals: " << statistics.num_skipped_removals << endl
+         << "Boosts: " << statistics.num_boosts << endl
+         << "Clears: " << statistics.num_clears << endl
+         << "Replay time: " << timer << endl
+         << "Time per operation: "
+         << (num_operations ? timer() * 1e9 / num_operations : 0.0)
+         << "ns" << endl
+         << "Peak memory before replay: " << peak_memory_before << " KB"
+         << endl
+         << "Peak memory: " << utils::get_peak_memory_in_kb() << " KB"
+         << endl;
+    return 0;
+}
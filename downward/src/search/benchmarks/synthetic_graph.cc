@@ -0,0 +1,213 @@
+#include "synthetic_graph.h"
+
+#include "../utils/collections.h"
+#include "../utils/rng.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <deque>
+
+using namespace std;
+
+namespace synthetic_graph {
+int SyntheticGraph::get_num_edges() const {
+    int num_edges = 0;
+    for (const vector<int> &succs : successors) {
+        num_edges += succs.size();
+    }
+    return num_edges;
+}
+
+static vector<vector<int>> generate_gnp_digraph(
+    int num_nodes, double edge_probability,
+    utils::RandomNumberGenerator &rng) {
+    assert(edge_probability > 0 && edge_probability < 1);
+    vector<vector<int>> successors(num_nodes);
+    /*
+      Skip over the non-edges with geometrically distributed jumps
+      instead of flipping a coin for every ordered pair of nodes.
+    */
+    double log_q = log(1.0 - edge_probability);
+    int v = 0;
+    long long w = -1;
+    while (v < num_nodes) {
+        double log_r = log(1.0 - rng());
+        w += 1 + static_cast<long long>(log_r / log_q);
+        if (v == w) {
+            // Avoid self-loops.
+            ++w;
+        }
+        while (v < num_nodes && w >= num_nodes) {
+            w -= num_nodes;
+            ++v;
+            if (v == w)
+                ++w;
+        }
+        if (v < num_nodes)
+            successors[v].push_back(static_cast<int>(w));
+    }
+    return successors;
+}
+
+static vector<int> compute_goal_distances(
+    const vector<vector<int>> &successors, int goal_node) {
+    int num_nodes = successors.size();
+    vector<vector<int>> predecessors(num_nodes);
+    for (int u = 0; u < num_nodes; ++u) {
+        for (int v : successors[u]) {
+            predecessors[v].push_back(u);
+        }
+    }
+
+    vector<int> distances(num_nodes, UNREACHABLE);
+    deque<int> queue;
+    distances[goal_node] = 0;
+    queue.push_back(goal_node);
+    while (!queue.empty()) {
+        int v = queue.front();
+        queue.pop_front();
+        for (int u : predecessors[v]) {
+            if (distances[u] == UNREACHABLE) {
+                distances[u] = distances[v] + 1;
+                queue.push_back(u);
+            }
+        }
+    }
+    return distances;
+}
+
+SyntheticGraph generate_random_instance(
+    int num_nodes, double edge_probability, int min_edges,
+    utils::RandomNumberGenerator &rng) {
+    SyntheticGraph graph;
+    do {
+        graph.successors = generate_gnp_digraph(num_nodes, edge_probability, rng);
+    } while (graph.get_num_edges() < max(min_edges, 1));
+
+    vector<bool> has_predecessor(num_nodes, false);
+    for (const vector<int> &succs : graph.successors) {
+        for (int v : succs) {
+            has_predecessor[v] = true;
+        }
+    }
+    vector<int> goal_candidates;
+    for (int v = 0; v < num_nodes; ++v) {
+        if (has_predecessor[v])
+            goal_candidates.push_back(v);
+    }
+    graph.goal_node = *rng.choose(goal_candidates);
+    graph.goal_distances = compute_goal_distances(
+        graph.successors, graph.goal_node);
+
+    /*
+      The goal has a predecessor and there are no self-loops, so there
+      is at least one candidate for the initial node.
+    */
+    vector<int> initial_candidates;
+    for (int v = 0; v < num_nodes; ++v) {
+        int distance = graph.goal_distances[v];
+        if (distance != UNREACHABLE && distance != 0)
+            initial_candidates.push_back(v);
+    }
+    assert(!initial_candidates.empty());
+    graph.initial_node = *rng.choose(initial_candidates);
+    return graph;
+}
+
+vector<int> compute_local_minima_heuristic(
+    const SyntheticGraph &graph, int delta) {
+    vector<int> h_values;
+    h_values.reserve(graph.get_num_nodes());
+    for (int distance : graph.goal_distances) {
+        if (distance == UNREACHABLE || distance == 0) {
+            h_values.push_back(distance);
+        } else if (distance % (delta + 1) == 1) {
+            h_values.push_back(distance + delta);
+        } else {
+            h_values.push_back(distance - 1);
+        }
+    }
+    return h_values;
+}
+
+static vector<int> compute_ranks(const vector<int> &values) {
+    vector<int> sorted_values = values;
+    utils::sort_unique(sorted_values);
+    vector<int> ranks;
+    ranks.reserve(values.size());
+    for (int value : values) {
+        ranks.push_back(
+            lower_bound(sorted_values.begin(), sorted_values.end(), value) -
+            sorted_values.begin());
+    }
+    return ranks;
+}
+
+static double count_tied_pairs(const vector<long long> &counts) {
+    double tied_pairs = 0;
+    for (long long count : counts) {
+        tied_pairs += 0.5 * count * (count - 1);
+    }
+    return tied_pairs;
+}
+
+double compute_goal_distance_rank_correlation(
+    const SyntheticGraph &graph, const vector<int> &h_values) {
+    vector<int> xs;
+    vector<int> ys;
+    for (int v = 0; v < graph.get_num_nodes(); ++v) {
+        if (graph.goal_distances[v] != UNREACHABLE) {
+            xs.push_back(h_values[v]);
+            ys.push_back(graph.goal_distances[v]);
+        }
+    }
+
+    /*
+      Both h and d* take few distinct values, so we count concordant and
+      discordant pairs on the contingency table of the two rankings
+      instead of comparing all pairs of nodes.
+    */
+    vector<int> x_ranks = compute_ranks(xs);
+    vector<int> y_ranks = compute_ranks(ys);
+    int num_x = *max_element(x_ranks.begin(), x_ranks.end()) + 1;
+    int num_y = *max_element(y_ranks.begin(), y_ranks.end()) + 1;
+    vector<vector<long long>> table(num_x, vector<long long>(num_y, 0));
+    vector<long long> x_counts(num_x, 0);
+    vector<long long> y_counts(num_y, 0);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        ++table[x_ranks[i]][y_ranks[i]];
+        ++x_counts[x_ranks[i]];
+        ++y_counts[y_ranks[i]];
+    }
+
+    // below[y] counts pairs with a larger x rank and a y rank of at most y.
+    vector<long long> below(num_y, 0);
+    double concordant_minus_discordant = 0;
+    for (int x = num_x - 1; x >= 0; --x) {
+        long long total_larger_x = below.back();
+        for (int y = 0; y < num_y; ++y) {
+            long long count = table[x][y];
+            if (count == 0)
+                continue;
+            long long smaller_y = (y > 0) ? below[y - 1] : 0;
+            long long larger_y = total_larger_x - below[y];
+            concordant_minus_discordant +=
+                static_cast<double>(count) * (larger_y - smaller_y);
+        }
+        long long row_sum = 0;
+        for (int y = 0; y < num_y; ++y) {
+            row_sum += table[x][y];
+            below[y] += row_sum;
+        }
+    }
+
+    double num_values = xs.size();
+    double num_pairs = 0.5 * num_values * (num_values - 1);
+    double denominator = sqrt((num_pairs - count_tied_pairs(x_counts)) *
+                              (num_pairs - count_tied_pairs(y_counts)));
+    if (denominator == 0)
+        return numeric_limits<double>::quiet_NaN();
+    return concordant_minus_discordant / denominator;
+}
+}
@@ -0,0 +1,68 @@
+#ifndef BENCHMARKS_SYNTHETIC_GRAPH_H
+#define BENCHMARKS_SYNTHETIC_GRAPH_H
+
+#include <limits>
+#include <vector>
+
+namespace utils {
+class RandomNumberGenerator;
+}
+
+/*
+  Synthetic search problems used to study exploration policies in
+  isolation from planning tasks. They mirror the instances generated by
+  random_digraph.py in the repository root: a random G(n, p) digraph, a
+  goal node with at least one incoming edge, a random initial node that
+  can reach the goal, and a heuristic with local minima of depth delta.
+*/
+namespace synthetic_graph {
+const int UNREACHABLE = std::numeric_limits<int>::max();
+
+struct SyntheticGraph {
+    // successors[u] lists all v with an edge (u, v).
+    std::vector<std::vector<int>> successors;
+    int initial_node;
+    int goal_node;
+    /*
+      Goal distance of every node (d* in the paper) or UNREACHABLE if
+      the goal cannot be reached from the node.
+    */
+    std::vector<int> goal_distances;
+
+    int get_num_nodes() const {
+        return successors.size();
+    }
+
+    int get_num_edges() const;
+};
+
+/*
+  Generate a G(n, p) digraph with the algorithm of Batagelj and Brandes
+  (as networkx.fast_gnp_random_graph does) and retry until it has at
+  least min_edges edges. Then pick the goal and initial node like
+  random_digraph.py.
+*/
+extern SyntheticGraph generate_random_instance(
+    int num_nodes, double edge_probability, int min_edges,
+    utils::RandomNumberGenerator &rng);
+
+/*
+  Heuristic of random_digraph.py with local minima of depth delta: every
+  (delta + 1)-th goal distance layer is overestimated by delta, all
+  other layers are underestimated by one. Unreachable nodes are
+  assigned UNREACHABLE.
+*/
+extern std::vector<int> compute_local_minima_heuristic(
+    const SyntheticGraph &graph, int delta);
+
+/*
+  Kendall rank correlation coefficient (tau-b) between the heuristic
+  and the goal distances of all nodes that can reach the goal. This is
+  the goal distance rank correlation (GDRC) reported for the synthetic
+  experiments.
+*/
+extern double compute_goal_distance_rank_correlation(
+    const SyntheticGraph &graph, const std::vector<int> &h_values);
+}
+
+#endif
@@ -0,0 +1,400 @@
+/*
+  Benchmark exploration policies on synthetic graphs.
+
+  This is a C++ version of random_digraph.py in the repository root. It
+  generates random G(n, p) digraphs with heuristics that have local
+  minima of depth delta and runs greedy best-first search with the
+  given open lists on them. The open lists are created from the regular
+  OpenList plugins, so any configuration accepted by the planner can be
+  benchmarked, as long as it only uses the predefined evaluator "h" (the
+  synthetic heuristic) and path-dependent evaluators such as g().
+
+  Trials are distributed over several threads. Trial i uses the same
+  instance for all values of delta, and all random choices depend only
+  on the seed and i, so the result does not depend on the number of
+  threads. Randomized open lists should use "random_seed={seed}", which
+  is replaced by a seed derived from the trial; with the default seed
+  (-1), all open lists in all threads share the global random number
+  generator, which is not thread-safe. "{delta}" is replaced by the
+  depth of the local minima of the current run, which the "cheating"
+  policy of random_digraph.py uses to restrict the h-values it explores.
+
+  The result is written in the JSON format of random_digraph.py: for
+  every configuration and for "gdrc" (the goal distance rank
+  correlation), the minimum, median and maximum number of expansions
+  over all trials is reported for each value of delta.
+*/
+
+#include "synthetic_graph.h"
+#include "synthetic_task.h"
+
+#include "../evaluation_context.h"
+#include "../open_list_factory.h"
+#include "../option_parser.h"
+#include "../per_state_information.h"
+#include "../state_registry.h"
+#include "../task_proxy.h"
+
+#include "../options/predefinitions.h"
+#include "../options/registries.h"
+#include "../utils/memory.h"
+#include "../utils/rng.h"
+#include "../utils/strings.h"
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace synthetic_graph;
+
+struct SearchConfig {
+    string name;
+    string open_list;
+};
+
+struct BenchmarkOptions {
+    int num_trials = 1000;
+    int num_nodes = 10000;
+    double gamma = 2.0;
+    int min_edges = 1000;
+    vector<int> deltas = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    string output_filename;
+    int seed = 2021;
+    int num_threads = max(1u, thread::hardware_concurrency());
+    vector<SearchConfig> configs;
+};
+
+static const vector<SearchConfig> DEFAULT_CONFIGS = {
+    {"gbfs", "single(h)"},
+    {"type", "alt([single(h), type_based([h, g()], random_seed={seed})])"},
+    {"type-h", "alt([single(h), softmin_type_based([h, g()], ignore_size=true, "
+     "ignore_weights=true, random_seed={seed})])"},
+    {"3-type-h", "alt([single(h), nth_type_based([h, g()], n=3, "
+     "ignore_size=true, random_seed={seed})])"},
+    {"lin-type-h", "alt([single(h), linear_weighted_type_based([h, g()], "
+     "ignore_size=true, random_seed={seed})])"},
+    {"softmin-type-h", "alt([single(h), softmin_type_based([h, g()], "
+     "ignore_size=true, random_seed={seed})])"},
+    {"cheating-type-h", "alt([single(h), nth_type_based([h, g()], "
+     "n=infinity, max_difference={delta}, ignore_size=true, "
+     "random_seed={seed})])"},
+};
+
+static const string GDRC = "gdrc";
+static const string SEED_PLACEHOLDER = "{seed}";
+static const string DELTA_PLACEHOLDER = "{delta}";
+
+/*
+  Creating and destroying tasks and state registries modifies global
+  per-task information (state packers, axiom evaluators), and the
+  option parser is not meant to be used concurrently either. All of
+  this is cheap compared to the search, so we simply serialize it.
+*/
+static mutex setup_mutex;
+
+
+static void replace_all(
+    string &text, const string &placeholder, const string &value) {
+    size_t pos;
+    while ((pos = text.find(placeholder)) != string::npos) {
+        text.replace(pos, placeholder.size(), value);
+    }
+}
+
+static string instantiate_config(const string &config, int seed, int delta) {
+    string result = config;
+    replace_all(result, SEED_PLACEHOLDER, to_string(seed));
+    replace_all(result, DELTA_PLACEHOLDER, to_string(delta));
+    return result;
+}
+
+static shared_ptr<OpenListFactory> parse_open_list(
+    const string &config, const shared_ptr<Evaluator> &heuristic,
+    options::Registry &registry, bool dry_run) {
+    options::Predefinitions predefinitions;
+    predefinitions.predefine("h", heuristic);
+    OptionParser parser(config, registry, predefinitions, dry_run);
+    return parser.start_parsing<shared_ptr<OpenListFactory>>();
+}
+
+/*
+  Greedy best-first search without reopening like type_gbfs in
+  random_digraph.py: states are inserted into the open list when they
+  are generated for the first time and the number of expansions up to
+  and including the expansion of the goal is returned.
+*/
+static int run_search(
+    const SyntheticTask &task, StateRegistry &state_registry,
+    StateOpenList &open_list) {
+    TaskProxy task_proxy(task);
+    OperatorsProxy operators = task_proxy.get_operators();
+    FactPair goal = task.get_goal_fact(0);
+
+    PerStateInformation<int> g_values(-1);
+    PerStateInformation<bool> closed(false);
+
+    const State &initial_state = state_registry.get_initial_state();
+    g_values[initial_state] = 0;
+    EvaluationContext initial_context(initial_state, 0, false, nullptr);
+    open_list.insert(initial_context, initial_state.get_id());
+
+    int num_expansions = 0;
+    while (!open_list.empty()) {
+        StateID id = open_list.remove_min();
+        State state = state_registry.lookup_state(id);
+        if (closed[state])
+            continue;
+        closed[state] = true;
+        ++num_expansions;
+
+        int node = state[0].get_value();
+        if (node == goal.value)
+            break;
+
+        int succ_g = g_values[state] + 1;
+        for (int op_id = task.get_first_operator(node);
+             op_id < task.get_first_operator(node + 1); ++op_id) {
+            State succ_state = state_registry.get_successor_state(
+                state, operators[op_id]);
+            int &g = g_values[succ_state];
+            if (g != -1)
+                continue;
+            g = succ_g;
+            EvaluationContext succ_context(succ_state, succ_g, false, nullptr);
+            open_list.insert(succ_context, succ_state.get_id());
+        }
+    }
+    return num_expansions;
+}
+
+static int run_config(
+    const SyntheticGraph &graph, const vector<int> &h_values,
+    const string &config, options::Registry &registry) {
+    shared_ptr<SyntheticTask> task;
+    unique_ptr<StateRegistry> state_registry;
+    unique_ptr<StateOpenList> open_list;
+    {
+        lock_guard<mutex> lock(setup_mutex);
+        task = make_shared<SyntheticTask>(graph);
+        state_registry = utils::make_unique_ptr<StateRegistry>(TaskProxy(*task));
+        shared_ptr<Evaluator> heuristic = make_shared<SyntheticHeuristic>(h_values);
+        open_list = parse_open_list(config, heuristic, registry, false)
+            ->create_state_open_list();
+    }
+
+    int num_expansions = run_search(*task, *state_registry, *open_list);
+
+    {
+        lock_guard<mutex> lock(setup_mutex);
+        open_list = nullptr;
+        state_registry = nullptr;
+        task = nullptr;
+    }
+    return num_expansions;
+}
+
+/*
+  results[config][delta][trial] holds the number of expansions (or the
+  rank correlation for GDRC).
+*/
+using Results = vector<vector<vector<double>>>;
+
+static void run_trial(
+    const BenchmarkOptions &options, int trial,
+    options::Registry &registry, Results &results) {
+    int trial_seed = options.seed + trial;
+    utils::RandomNumberGenerator rng(trial_seed);
+    double edge_probability = options.gamma / (options.num_nodes - 1);
+    SyntheticGraph graph = generate_random_instance(
+        options.num_nodes, edge_probability, options.min_edges, rng);
+
+    int num_configs = options.configs.size();
+    for (size_t delta_id = 0; delta_id < options.deltas.size(); ++delta_id) {
+        int delta = options.deltas[delta_id];
+        vector<int> h_values = compute_local_minima_heuristic(graph, delta);
+        for (int config_id = 0; config_id < num_configs; ++config_id) {
+            string config = instantiate_config(
+                options.configs[config_id].open_list, trial_seed, delta);
+            results[config_id][delta_id][trial] =
+                run_config(graph, h_values, config, registry);
+        }
+        results[num_configs][delta_id][trial] =
+            compute_goal_distance_rank_correlation(graph, h_values);
+    }
+}
+
+static double compute_median(vector<double> values) {
+    assert(!values.empty());
+    sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    if (values.size() % 2 == 1)
+        return values[mid];
+    return 0.5 * (values[mid - 1] + values[mid]);
+}
+
+static void write_number(ostream &out, double value) {
+    if (std::isnan(value))
+        out << "NaN";
+    else if (value == floor(value) && abs(value) < 1e15)
+        out << static_cast<long long>(value);
+    else
+        out << setprecision(17) << value;
+}
+
+static void write_results(
+    ostream &out, const BenchmarkOptions &options, const Results &results) {
+    vector<string> names;
+    for (const SearchConfig &config : options.configs) {
+        names.push_back(config.name);
+    }
+    names.push_back(GDRC);
+
+    out << "{" << endl;
+    for (size_t config_id = 0; config_id < names.size(); ++config_id) {
+        out << "    \"" << names[config_id] << "\": {" << endl;
+        const vector<string> statistics = {"min", "median", "max"};
+        for (size_t stat_id = 0; stat_id < statistics.size(); ++stat_id) {
+            const string &statistic = statistics[stat_id];
+            out << "        \"" << statistic << "\": {" << endl;
+            for (size_t delta_id = 0; delta_id < options.deltas.size(); ++delta_id) {
+                const vector<double> &values = results[config_id][delta_id];
+                double value;
+                if (statistic == "min")
+                    value = *min_element(values.begin(), values.end());
+                else if (statistic == "max")
+                    value = *max_element(values.begin(), values.end());
+                else
+                    value = compute_median(values);
+                out << "            \"" << options.deltas[delta_id] << "\": ";
+                write_number(out, value);
+                out << (delta_id + 1 < options.deltas.size() ? "," : "") << endl;
+            }
+            out << "        }" << (stat_id + 1 < statistics.size() ? "," : "") << endl;
+        }
+        out << "    }" << (config_id + 1 < names.size() ? "," : "") << endl;
+    }
+    out << "}" << endl;
+}
+
+static void print_usage(const char *program) {
+    cerr << "usage: " << program << " --output FILE [--trials N] [--nodes N]"
+         << " [--gamma X] [--minsize N] [--delta D [D ...]] [--seed N]"
+         << " [--threads N] [--config NAME=OPEN_LIST ...]" << endl
+         << "Without --config, the exploration policies of random_digraph.py"
+         << " are used:" << endl;
+    for (const SearchConfig &config : DEFAULT_CONFIGS) {
+        cerr << "    " << config.name << "=" << config.open_list << endl;
+    }
+}
+
+static bool parse_arguments(int argc, char **argv, BenchmarkOptions &options) {
+    vector<string> args(argv + 1, argv + argc);
+    try {
+        for (size_t i = 0; i < args.size(); ++i) {
+            const string &arg = args[i];
+            bool has_value = i + 1 < args.size();
+            if (!has_value)
+                return false;
+            if (arg == "--trials" || arg == "-t") {
+                options.num_trials = stoi(args[++i]);
+            } else if (arg == "--nodes" || arg == "-n") {
+                options.num_nodes = stoi(args[++i]);
+            } else if (arg == "--gamma" || arg == "-g") {
+                options.gamma = stod(args[++i]);
+            } else if (arg == "--minsize" || arg == "-m") {
+                options.min_edges = static_cast<int>(stod(args[++i]));
+            } else if (arg == "--delta" || arg == "-d") {
+                options.deltas.clear();
+                while (i + 1 < args.size() && !utils::startswith(args[i + 1], "-"))
+                    options.deltas.push_back(stoi(args[++i]));
+            } else if (arg == "--output" || arg == "-o") {
+                options.output_filename = args[++i];
+            } else if (arg == "--seed" || arg == "-s") {
+                options.seed = stoi(args[++i]);
+            } else if (arg == "--threads" || arg == "-j") {
+                options.num_threads = stoi(args[++i]);
+            } else if (arg == "--config" || arg == "-c") {
+                pair<string, string> name_and_config = utils::split(args[++i], "=");
+                options.configs.push_back(
+                    {name_and_config.first, name_and_config.second});
+            } else {
+                return false;
+            }
+        }
+    } catch (const exception &) {
+        return false;
+    }
+    if (options.configs.empty())
+        options.configs = DEFAULT_CONFIGS;
+    double edge_probability = options.gamma / (options.num_nodes - 1);
+    return !options.output_filename.empty() && !options.deltas.empty() &&
+           options.num_trials > 0 && options.num_nodes > 1 &&
+           options.num_threads > 0 &&
+           edge_probability > 0 && edge_probability < 1 &&
+           all_of(options.deltas.begin(), options.deltas.end(),
+                  [](int delta) {return delta >= 0;});
+}
+
+int main(int argc, char **argv) {
+    BenchmarkOptions options;
+    if (!parse_arguments(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    options::Registry registry(*options::RawRegistry::instance());
+    const vector<int> no_h_values;
+    for (const SearchConfig &config : options.configs) {
+        try {
+            parse_open_list(instantiate_config(config.open_list, 0, 0),
+                            make_shared<SyntheticHeuristic>(no_h_values),
+                            registry, true);
+        } catch (const utils::Exception &error) {
+            cerr << "invalid configuration " << config.name << ": ";
+            error.print();
+            return 2;
+        }
+    }
+
+    Results results(
+        options.configs.size() + 1,
+        vector<vector<double>>(options.deltas.size(),
+                               vector<double>(options.num_trials)));
+
+    utils::WallClockTimer timer;
+    atomic<int> next_trial(0);
+    atomic<int> num_finished_trials(0);
+    mutex output_mutex;
+    auto worker = [&]() {
+            while (true) {
+                int trial = next_trial++;
+                if (trial >= options.num_trials)
+                    break;
+                run_trial(options, trial, registry, results);
+                int num_finished = ++num_finished_trials;
+                lock_guard<mutex> lock(output_mutex);
+                cout << "finished trial " << trial << " (" << num_finished
+                     << "/" << options.num_trials << ", " << timer << ")"
+                     << endl;
+            }
+        };
+    vector<thread> threads;
+    for (int i = 0; i < options.num_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+
+    ofstream out(options.output_filename);
+    write_results(out, options, results);
+    cout << "Total time: " << timer << endl;
+    return out ? 0 : 1;
+}
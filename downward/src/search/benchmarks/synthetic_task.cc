@@ -0,0 +1,148 @@
+#include "synthetic_task.h"
+
+#include "synthetic_graph.h"
+
+#include "../evaluation_context.h"
+#include "../evaluation_result.h"
+
+#include "../utils/collections.h"
+#include "../utils/system.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace synthetic_graph {
+SyntheticTask::SyntheticTask(const SyntheticGraph &graph)
+    : graph(graph) {
+    int num_nodes = graph.get_num_nodes();
+    first_operator.reserve(num_nodes + 1);
+    operator_sources.reserve(graph.get_num_edges());
+    for (int u = 0; u < num_nodes; ++u) {
+        first_operator.push_back(operator_sources.size());
+        operator_sources.insert(
+            operator_sources.end(), graph.successors[u].size(), u);
+    }
+    first_operator.push_back(operator_sources.size());
+}
+
+int SyntheticTask::get_operator_target(int index) const {
+    assert(utils::in_bounds(index, operator_sources));
+    int source = operator_sources[index];
+    return graph.successors[source][index - first_operator[source]];
+}
+
+int SyntheticTask::get_num_variables() const {
+    return 1;
+}
+
+string SyntheticTask::get_variable_name(int) const {
+    return "node";
+}
+
+int SyntheticTask::get_variable_domain_size(int) const {
+    return graph.get_num_nodes();
+}
+
+int SyntheticTask::get_variable_axiom_layer(int) const {
+    return -1;
+}
+
+int SyntheticTask::get_variable_default_axiom_value(int) const {
+    return 0;
+}
+
+string SyntheticTask::get_fact_name(const FactPair &fact) const {
+    return "node " + to_string(fact.value);
+}
+
+bool SyntheticTask::are_facts_mutex(
+    const FactPair &fact1, const FactPair &fact2) const {
+    return fact1.var == fact2.var && fact1.value != fact2.value;
+}
+
+int SyntheticTask::get_operator_cost(int, bool) const {
+    return 1;
+}
+
+string SyntheticTask::get_operator_name(int index, bool) const {
+    return "edge " + to_string(operator_sources[index]) + " " +
+           to_string(get_operator_target(index));
+}
+
+int SyntheticTask::get_num_operators() const {
+    return operator_sources.size();
+}
+
+int SyntheticTask::get_num_operator_preconditions(int, bool) const {
+    return 1;
+}
+
+FactPair SyntheticTask::get_operator_precondition(
+    int op_index, int, bool) const {
+    return FactPair(0, operator_sources[op_index]);
+}
+
+int SyntheticTask::get_num_operator_effects(int, bool) const {
+    return 1;
+}
+
+int SyntheticTask::get_num_operator_effect_conditions(int, int, bool) const {
+    return 0;
+}
+
+FactPair SyntheticTask::get_operator_effect_condition(
+    int, int, int, bool) const {
+    ABORT("Synthetic tasks have no conditional effects.");
+}
+
+FactPair SyntheticTask::get_operator_effect(int op_index, int, bool) const {
+    return FactPair(0, get_operator_target(op_index));
+}
+
+int SyntheticTask::convert_operator_index(
+    int index, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid operator ID conversion");
+    }
+    return index;
+}
+
+int SyntheticTask::get_num_axioms() const {
+    return 0;
+}
+
+int SyntheticTask::get_num_goals() const {
+    return 1;
+}
+
+FactPair SyntheticTask::get_goal_fact(int) const {
+    return FactPair(0, graph.goal_node);
+}
+
+vector<int> SyntheticTask::get_initial_state_values() const {
+    return {graph.initial_node};
+}
+
+void SyntheticTask::convert_state_values(
+    vector<int> &, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion");
+    }
+}
+
+
+SyntheticHeuristic::SyntheticHeuristic(const vector<int> &h_values)
+    : Evaluator("h"),
+      h_values(h_values) {
+}
+
+EvaluationResult SyntheticHeuristic::compute_result(
+    EvaluationContext &eval_context) {
+    int h = h_values[eval_context.get_state()[0].get_value()];
+    EvaluationResult result;
+    result.set_evaluator_value(
+        h == UNREACHABLE ? EvaluationResult::INFTY : h);
+    return result;
+}
+}
@@ -0,0 +1,93 @@
+#ifndef BENCHMARKS_SYNTHETIC_TASK_H
+#define BENCHMARKS_SYNTHETIC_TASK_H
+
+#include "../abstract_task.h"
+#include "../evaluator.h"
+
+#include <vector>
+
+namespace synthetic_graph {
+struct SyntheticGraph;
+
+/*
+  Planning task view of a synthetic graph: a single variable whose
+  value is the current node and one unit-cost operator per edge. This
+  lets us use StateRegistry, PerStateInformation and the open lists of
+  the planner on synthetic instances without any translation step.
+
+  Operator i corresponds to the i-th edge in the order given by the
+  successor lists, so the outgoing edges of node u are the operators
+  get_first_operator(u), ..., get_first_operator(u + 1) - 1.
+*/
+class SyntheticTask : public AbstractTask {
+    const SyntheticGraph &graph;
+    std::vector<int> first_operator;
+    std::vector<int> operator_sources;
+
+    int get_operator_target(int index) const;
+public:
+    explicit SyntheticTask(const SyntheticGraph &graph);
+
+    int get_first_operator(int node) const {
+        return first_operator[node];
+    }
+
+    virtual int get_num_variables() const override;
+    virtual std::string get_variable_name(int var) const override;
+    virtual int get_variable_domain_size(int var) const override;
+    virtual int get_variable_axiom_layer(int var) const override;
+    virtual int get_variable_default_axiom_value(int var) const override;
+    virtual std::string get_fact_name(const FactPair &fact) const override;
+    virtual bool are_facts_mutex(
+        const FactPair &fact1, const FactPair &fact2) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override;
+    virtual std::string get_operator_name(
+        int index, bool is_axiom) const override;
+    virtual int get_num_operators() const override;
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override;
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override;
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index,
+        bool is_axiom) const override;
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual int convert_operator_index(
+        int index, const AbstractTask *ancestor_task) const override;
+
+    virtual int get_num_axioms() const override;
+
+    virtual int get_num_goals() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual std::vector<int> get_initial_state_values() const override;
+    virtual void convert_state_values(
+        std::vector<int> &values,
+        const AbstractTask *ancestor_task) const override;
+};
+
+/*
+  Evaluator that looks up precomputed heuristic values of the node
+  represented by a state of a SyntheticTask. Nodes with value
+  UNREACHABLE are reported as (reliable) dead ends.
+*/
+class SyntheticHeuristic : public Evaluator {
+    const std::vector<int> &h_values;
+public:
+    explicit SyntheticHeuristic(const std::vector<int> &h_values);
+    virtual ~SyntheticHeuristic() override = default;
+
+    virtual EvaluationResult compute_result(
+        EvaluationContext &eval_context) override;
+
+    virtual void get_path_dependent_evaluators(std::set<Evaluator *> &) override {}
+};
+}
+
+#endif
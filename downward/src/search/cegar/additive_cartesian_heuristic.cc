@@ -10,6 +10,7 @@
 
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
@@ -33,7 +34,8 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         opts.get<bool>("use_general_costs"),
         opts.get<PickSplit>("pick"),
         *rng,
-        opts.get<bool>("debug"));
+        opts.get<bool>("debug"),
+        opts.get<int>("threads"));
     return cost_saturation.generate_heuristic_functions(
         opts.get<shared_ptr<AbstractTask>>("transform"));
 }
@@ -118,7 +120,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         Bounds("0", "infinity"));
     parser.add_option<double>(
         "max_time",
-        "maximum time in seconds for building abstractions",
+        "maximum wall-clock time in seconds for building abstractions",
         "infinity",
         Bounds("0.0", "infinity"));
     vector<string> pick_strategies;
@@ -139,9 +141,24 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "debug",
         "print debugging output",
         "false");
+    utils::add_threads_option_to_parser(
+        parser,
+        "number of threads for refining the abstractions of consecutive "
+        "subtasks concurrently. With more than one thread, the subtasks are "
+        "refined in batches for the costs that remain before each batch, so "
+        "the resulting heuristic depends on this number. If neither max_time "
+        "nor the memory limit is hit, it does not depend on the thread "
+        "scheduling, so runs with the same number of threads give identical "
+        "heuristics. Otherwise, where the refinements stop depends on the "
+        "scheduling");
     Heuristic::add_options_to_parser(parser);
     utils::add_rng_options(parser);
     Options opts = parser.parse();
+    if (parser.help_mode())
+        return nullptr;
+
+    if (opts.get<bool>("debug") && opts.get<int>("threads") > 1)
+        parser.error("debugging output is only supported with threads=1");
 
     if (parser.dry_run())
         return nullptr;
@@ -7,6 +7,7 @@
 #include "../task_proxy.h"
 
 #include "../utils/countdown_timer.h"
+#include "../utils/logging.h"
 
 #include <memory>
 
@@ -36,10 +37,16 @@ class CEGAR {
     std::unique_ptr<Abstraction> abstraction;
     AbstractSearch abstract_search;
 
-    // Limit the time for building the abstraction.
-    utils::CountdownTimer timer;
+    /*
+      Limit the time for building the abstraction. We count wall-clock time
+      since several abstractions may be refined concurrently. The countdown
+      starts in refine_abstraction, so the time for setting up the CEGAR
+      objects of a batch is not counted.
+    */
+    utils::WallClockCountdownTimer timer;
 
     const bool debug;
+    utils::Verbosity verbosity;
 
     bool may_keep_refining() const;
 
@@ -60,8 +67,6 @@ class CEGAR {
     // Build abstraction.
     void refinement_loop(utils::RandomNumberGenerator &rng);
 
-    void print_statistics();
-
 public:
     CEGAR(
         const std::shared_ptr<AbstractTask> &task,
@@ -69,12 +74,22 @@ public:
         int max_non_looping_transitions,
         double max_time,
         PickSplit pick,
-        utils::RandomNumberGenerator &rng,
         bool debug);
     ~CEGAR();
 
     CEGAR(const CEGAR &) = delete;
 
+    /*
+      Refine the abstraction until a limit is reached. With verbosity
+      SILENT (and without debug output), this method does not write to
+      the log and only uses the given random number generator, so
+      several CEGAR objects can refine their abstractions concurrently.
+    */
+    void refine_abstraction(
+        utils::RandomNumberGenerator &rng, utils::Verbosity verbosity);
+
+    void print_statistics();
+
     std::unique_ptr<Abstraction> extract_abstraction();
 };
 }
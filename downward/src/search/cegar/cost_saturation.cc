@@ -14,9 +14,12 @@
 #include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
 #include "../utils/memory.h"
+#include "../utils/parallel.h"
+#include "../utils/rng.h"
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 using namespace std;
 
@@ -89,7 +92,8 @@ CostSaturation::CostSaturation(
     bool use_general_costs,
     PickSplit pick_split,
     utils::RandomNumberGenerator &rng,
-    bool debug)
+    bool debug,
+    int num_threads)
     : subtask_generators(subtask_generators),
       max_states(max_states),
       max_non_looping_transitions(max_non_looping_transitions),
@@ -98,6 +102,7 @@ CostSaturation::CostSaturation(
       pick_split(pick_split),
       rng(rng),
       debug(debug),
+      num_threads(num_threads),
       num_abstractions(0),
       num_states(0),
       num_non_looping_transitions(0) {
@@ -108,7 +113,7 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
     // For simplicity this is a member object. Make sure it is in a valid state.
     assert(heuristic_functions.empty());
 
-    utils::CountdownTimer timer(max_time);
+    utils::WallClockCountdownTimer timer(max_time);
 
     TaskProxy task_proxy(*task);
 
@@ -189,54 +194,104 @@ bool CostSaturation::state_is_dead_end(const State &state) const {
 
 void CostSaturation::build_abstractions(
     const vector<shared_ptr<AbstractTask>> &subtasks,
-    const utils::CountdownTimer &timer,
+    const utils::WallClockCountdownTimer &timer,
     function<bool()> should_abort) {
-    int rem_subtasks = subtasks.size();
-    for (shared_ptr<AbstractTask> subtask : subtasks) {
-        subtask = get_remaining_costs_task(subtask);
+    int num_subtasks = subtasks.size();
+    for (int batch_begin = 0; batch_begin < num_subtasks;
+         batch_begin += num_threads) {
+        int rem_subtasks = num_subtasks - batch_begin;
+        int batch_size = min(num_threads, rem_subtasks);
 
+        /*
+          Each subtask of the batch gets the same share of the remaining
+          state and transition limits as in the sequential case. The time
+          limits count wall-clock time and the subtasks of a batch are
+          refined at the same time, so each of them may use the time that
+          the whole batch would get in the sequential case.
+        */
         assert(num_states < max_states);
-        CEGAR cegar(
-            subtask,
-            max(1, (max_states - num_states) / rem_subtasks),
-            max(1, (max_non_looping_transitions - num_non_looping_transitions) /
-                rem_subtasks),
-            timer.get_remaining_time() / rem_subtasks,
-            pick_split,
-            rng,
-            debug);
-
-        unique_ptr<Abstraction> abstraction = cegar.extract_abstraction();
-        ++num_abstractions;
-        num_states += abstraction->get_num_states();
-        num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
-        assert(num_states <= max_states);
-
-        vector<int> costs = task_properties::get_operator_costs(TaskProxy(*subtask));
-        vector<int> init_distances = compute_distances(
-            abstraction->get_transition_system().get_outgoing_transitions(),
-            costs,
-            {abstraction->get_initial_state().get_id()});
-        vector<int> goal_distances = compute_distances(
-            abstraction->get_transition_system().get_incoming_transitions(),
-            costs,
-            abstraction->get_goals());
-        vector<int> saturated_costs = compute_saturated_costs(
-            abstraction->get_transition_system(),
-            init_distances,
-            goal_distances,
-            use_general_costs);
-
-        heuristic_functions.emplace_back(
-            abstraction->extract_refinement_hierarchy(),
-            move(goal_distances));
-
-        reduce_remaining_costs(saturated_costs);
+        int subtask_max_states = max(1, (max_states - num_states) / rem_subtasks);
+        int subtask_max_transitions = max(
+            1, (max_non_looping_transitions - num_non_looping_transitions) /
+            rem_subtasks);
+        double subtask_max_time =
+            batch_size * timer.get_remaining_time() / rem_subtasks;
+
+        /* Set up the CEGAR objects sequentially, since computing the
+           split selector's relaxation heuristic writes to the log. */
+        vector<unique_ptr<CEGAR>> cegars;
+        cegars.reserve(batch_size);
+        for (int i = 0; i < batch_size; ++i) {
+            shared_ptr<AbstractTask> subtask = subtasks[batch_begin + i];
+            cegars.push_back(utils::make_unique_ptr<CEGAR>(
+                                 get_remaining_costs_task(subtask),
+                                 subtask_max_states,
+                                 subtask_max_transitions,
+                                 subtask_max_time,
+                                 pick_split,
+                                 debug));
+        }
 
-        if (should_abort())
-            break;
+        if (num_threads == 1) {
+            cegars[0]->refine_abstraction(rng, utils::Verbosity::NORMAL);
+        } else {
+            vector<unique_ptr<utils::RandomNumberGenerator>> rngs;
+            rngs.reserve(batch_size);
+            for (int i = 0; i < batch_size; ++i) {
+                rngs.push_back(utils::make_unique_ptr<utils::RandomNumberGenerator>(
+                                   rng(numeric_limits<int>::max())));
+            }
+            utils::parallel_for(
+                batch_size, num_threads,
+                [&](int i, int) {
+                    cegars[i]->refine_abstraction(
+                        *rngs[i], utils::Verbosity::SILENT);
+                });
+        }
 
-        --rem_subtasks;
+        for (int i = 0; i < batch_size; ++i) {
+            if (num_threads > 1) {
+                utils::g_log << "Done building abstraction "
+                             << batch_begin + i + 1 << "/" << num_subtasks
+                             << "." << endl;
+                cegars[i]->print_statistics();
+            }
+            unique_ptr<Abstraction> abstraction = cegars[i]->extract_abstraction();
+            cegars[i] = nullptr;
+            ++num_abstractions;
+            num_states += abstraction->get_num_states();
+            num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
+            assert(num_states <= max_states);
+
+            /*
+              The abstraction may have been refined for higher costs, but
+              saturating the remaining costs keeps the cost partitioning
+              admissible.
+            */
+            const vector<int> &costs = remaining_costs;
+            vector<int> init_distances = compute_distances(
+                abstraction->get_transition_system().get_outgoing_transitions(),
+                costs,
+                {abstraction->get_initial_state().get_id()});
+            vector<int> goal_distances = compute_distances(
+                abstraction->get_transition_system().get_incoming_transitions(),
+                costs,
+                abstraction->get_goals());
+            vector<int> saturated_costs = compute_saturated_costs(
+                abstraction->get_transition_system(),
+                init_distances,
+                goal_distances,
+                use_general_costs);
+
+            heuristic_functions.emplace_back(
+                abstraction->extract_refinement_hierarchy(),
+                move(goal_distances));
+
+            reduce_remaining_costs(saturated_costs);
+
+            if (should_abort())
+                return;
+        }
     }
 }
 
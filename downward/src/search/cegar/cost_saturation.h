@@ -8,9 +8,9 @@
 #include <vector>
 
 namespace utils {
-class CountdownTimer;
 class Duration;
 class RandomNumberGenerator;
+class WallClockCountdownTimer;
 }
 
 namespace cegar {
@@ -23,6 +23,14 @@ class SubtaskGenerator;
   RefinementHierarchies from Abstractions to
   CartesianHeuristicFunctions, allow extracting
   CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+
+  With multiple threads, the subtasks are processed in batches of
+  num_threads subtasks. All abstractions of a batch are refined
+  concurrently for the costs that remain before the batch. Afterwards,
+  the costs are saturated in the order of the subtasks. Unless the time
+  or memory limit is hit, the heuristic therefore only depends on the
+  number of threads, not on the thread scheduling. Where the refinements
+  stop when a time or memory limit is hit depends on the scheduling.
 */
 class CostSaturation {
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators;
@@ -33,6 +41,7 @@ class CostSaturation {
     const PickSplit pick_split;
     utils::RandomNumberGenerator &rng;
     const bool debug;
+    const int num_threads;
 
     std::vector<CartesianHeuristicFunction> heuristic_functions;
     std::vector<int> remaining_costs;
@@ -47,7 +56,7 @@ class CostSaturation {
     bool state_is_dead_end(const State &state) const;
     void build_abstractions(
         const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
-        const utils::CountdownTimer &timer,
+        const utils::WallClockCountdownTimer &timer,
         std::function<bool()> should_abort);
     void print_statistics(utils::Duration init_time) const;
 
@@ -60,7 +69,8 @@ public:
         bool use_general_costs,
         PickSplit pick_split,
         utils::RandomNumberGenerator &rng,
-        bool debug);
+        bool debug,
+        int num_threads);
 
     std::vector<CartesianHeuristicFunction> generate_heuristic_functions(
         const std::shared_ptr<AbstractTask> &task);
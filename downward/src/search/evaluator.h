@@ -53,6 +53,16 @@ public:
         const State & /*state*/) {
     }
 
+    /*
+      print_statistics is called when the search engine prints its
+      statistics, so evaluators can report what they collected during
+      the search.
+
+      The default implementation prints nothing.
+    */
+    virtual void print_statistics() const {
+    }
+
     /*
       compute_result should compute the estimate and possibly
       preferred operators for the given evaluation context and return
@@ -17,8 +17,23 @@ const int AdditiveHeuristic::MAX_COST_VALUE;
 // construction and destruction
 AdditiveHeuristic::AdditiveHeuristic(const Options &opts)
     : RelaxationHeuristic(opts),
-      did_write_overflow_warning(false) {
+      did_write_overflow_warning(false),
+      incremental(opts.get<bool>("incremental", false)) {
     utils::g_log << "Initializing additive heuristic..." << endl;
+    if (incremental)
+        build_achievers();
+}
+
+void AdditiveHeuristic::build_achievers() {
+    vector<vector<OpID>> achiever_vectors(propositions.size());
+    int num_unary_ops = unary_operators.size();
+    for (OpID op_id = 0; op_id < num_unary_ops; ++op_id)
+        achiever_vectors[unary_operators[op_id].effect].push_back(op_id);
+
+    for (const vector<OpID> &achiever_vec : achiever_vectors) {
+        achievers.push_back(achievers_pool.append(achiever_vec));
+        num_achievers.push_back(achiever_vec.size());
+    }
 }
 
 void AdditiveHeuristic::write_overflow_warning() {
@@ -42,13 +57,13 @@ void AdditiveHeuristic::setup_exploration_queue() {
         prop.marked = false;
     }
 
-    // Deal with operators and axioms without preconditions.
-    for (UnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.num_preconditions;
-        op.cost = op.base_cost; // will be increased by precondition costs
+    // Operator costs will be increased by precondition costs.
+    reset_explored_operators();
 
-        if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost, get_op_id(op));
+    // Deal with operators and axioms without preconditions.
+    for (OpID op_id : operators_without_preconditions) {
+        const UnaryOperator *op = get_operator(op_id);
+        enqueue_if_necessary(op->effect, op->base_cost, op_id);
     }
 }
 
@@ -71,17 +86,18 @@ void AdditiveHeuristic::relaxed_exploration() {
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
-        if (prop->is_goal && --unsolved_goals == 0)
+        // In incremental mode, we need the costs of all propositions.
+        if (!incremental && prop->is_goal && --unsolved_goals == 0)
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
-            UnaryOperator *unary_op = get_operator(op_id);
-            increase_cost(unary_op->cost, prop_cost);
-            --unary_op->unsatisfied_preconditions;
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect,
-                                     unary_op->cost, op_id);
+            ExploredOperator &explored_op = explored_operators[op_id];
+            increase_cost(explored_op.cost, prop_cost);
+            --explored_op.unsatisfied_preconditions;
+            assert(explored_op.unsatisfied_preconditions >= 0);
+            if (explored_op.unsatisfied_preconditions == 0)
+                enqueue_if_necessary(explored_op.effect,
+                                     explored_op.cost, op_id);
         }
     }
 }
@@ -112,10 +128,95 @@ void AdditiveHeuristic::mark_preferred_operators(
     }
 }
 
+void AdditiveHeuristic::invalidate(PropID prop_id) {
+    Proposition *prop = get_proposition(prop_id);
+    prop->cost = -1;
+    prop->reached_by = NO_OP;
+    invalidated_props.push_back(prop_id);
+}
+
+int AdditiveHeuristic::compute_operator_cost(OpID op_id) {
+    int cost = get_operator(op_id)->base_cost;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = get_proposition(precond)->cost;
+        if (precond_cost == -1)
+            return -1;
+        increase_cost(cost, precond_cost);
+    }
+    return cost;
+}
+
+void AdditiveHeuristic::update_exploration(const State &state) {
+    assert(queue.empty());
+    assert(invalidated_props.empty());
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+    int num_vars = values.size();
+
+    // Invalidate the removed facts and the propositions supported by them.
+    for (int var = 0; var < num_vars; ++var) {
+        if (values[var] != last_state_values[var])
+            invalidate(get_prop_id(var, last_state_values[var]));
+    }
+    for (size_t i = 0; i < invalidated_props.size(); ++i) {
+        Proposition *prop = get_proposition(invalidated_props[i]);
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            PropID effect = get_operator(op_id)->effect;
+            if (get_proposition(effect)->reached_by == op_id)
+                invalidate(effect);
+        }
+    }
+
+    // Enqueue the added facts and the invalidated propositions.
+    for (int var = 0; var < num_vars; ++var) {
+        if (values[var] != last_state_values[var]) {
+            enqueue_if_necessary(get_prop_id(var, values[var]), 0, NO_OP);
+            last_state_values[var] = values[var];
+        }
+    }
+    for (PropID prop_id : invalidated_props) {
+        for (OpID op_id : achievers_pool.get_slice(
+                 achievers[prop_id], num_achievers[prop_id])) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(prop_id, cost, op_id);
+        }
+    }
+    invalidated_props.clear();
+
+    for (Proposition &prop : propositions)
+        prop.marked = false;
+
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        Proposition *prop = get_proposition(prop_id);
+        assert(prop->cost >= 0 && prop->cost <= distance);
+        if (prop->cost < distance)
+            continue;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(get_operator(op_id)->effect, cost, op_id);
+        }
+    }
+}
+
 int AdditiveHeuristic::compute_add_and_ff(const State &state) {
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+    if (incremental && !last_state_values.empty()) {
+        update_exploration(state);
+    } else {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+        if (incremental) {
+            state.unpack();
+            last_state_values = state.get_unpacked_values();
+        }
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -142,6 +243,19 @@ void AdditiveHeuristic::compute_heuristic_for_cegar(const State &state) {
     compute_heuristic(state);
 }
 
+void add_options_to_parser(OptionParser &parser) {
+    Heuristic::add_options_to_parser(parser);
+    parser.add_option<bool>(
+        "incremental",
+        "compute the heuristic incrementally from the proposition costs of "
+        "the previously evaluated state. This computes the costs of all "
+        "propositions, so it only pays off if consecutively evaluated "
+        "states are similar, e.g., successors of the same state in eager "
+        "search. Relaxed plans and preferred operators may differ from the "
+        "non-incremental computation through tie-breaking.",
+        "false");
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis("Additive heuristic", "");
     parser.document_language_support("action costs", "supported");
@@ -156,7 +270,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "yes");
 
-    Heuristic::add_options_to_parser(parser);
+    add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
@@ -7,9 +7,14 @@
 #include "../utils/collections.h"
 
 #include <cassert>
+#include <vector>
 
 class State;
 
+namespace options {
+class OptionParser;
+}
+
 namespace additive_heuristic {
 using relaxation_heuristic::PropID;
 using relaxation_heuristic::OpID;
@@ -18,6 +23,7 @@ using relaxation_heuristic::NO_OP;
 
 using relaxation_heuristic::Proposition;
 using relaxation_heuristic::UnaryOperator;
+using relaxation_heuristic::ExploredOperator;
 
 class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     /* Costs larger than MAX_COST_VALUE are clamped to max_value. The
@@ -32,11 +38,37 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     priority_queues::AdaptiveQueue<PropID> queue;
     bool did_write_overflow_warning;
 
+    /*
+      In incremental mode, the costs of all propositions are computed
+      to the fixpoint (instead of stopping once all goals are reached),
+      and the next evaluation starts from the costs of the previously
+      evaluated state. Usually, this is the parent or a sibling of the
+      new state, so only a few facts differ. We first invalidate the
+      removed facts and all propositions whose cheapest achiever
+      (reached_by) depends on them, then reinitialize the invalidated
+      propositions from their achievers and the added facts with cost 0,
+      and finally propagate the cost decreases in Dijkstra fashion. This
+      computes the same h^add values as a full exploration. Ties between
+      equally cheap achievers may be broken differently, so relaxed
+      plans (and hence h^FF values) and preferred operators can differ.
+    */
+    const bool incremental;
+    std::vector<int> last_state_values;
+    array_pool::ArrayPool achievers_pool;
+    std::vector<array_pool::ArrayPoolIndex> achievers;
+    std::vector<int> num_achievers;
+    std::vector<PropID> invalidated_props;
+
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void relaxed_exploration();
     void mark_preferred_operators(const State &state, PropID goal_id);
 
+    void build_achievers();
+    void invalidate(PropID prop_id);
+    int compute_operator_cost(OpID op_id);
+    void update_exploration(const State &state);
+
     void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
         assert(cost >= 0);
         Proposition *prop = get_proposition(prop_id);
@@ -79,6 +111,8 @@ public:
         return get_proposition(var, value)->cost;
     }
 };
+
+extern void add_options_to_parser(options::OptionParser &parser);
 }
 
 #endif
@@ -74,11 +74,12 @@ struct LocalTransition {
 
 
 struct LocalProblemNode {
-    // Attributes fixed during initialization.
-    LocalProblem *owner;
-    vector<LocalTransition> outgoing_transitions;
-
-    // Dynamic attributes (modified during heuristic computation).
+    /*
+      Dynamic attributes (modified during heuristic computation). The
+      attributes accessed for every transition come first to keep them
+      in one cache line.
+    */
+    int generation;
     int cost;
     bool expanded;
     vector<short> context;
@@ -94,12 +95,17 @@ struct LocalProblemNode {
 
     vector<LocalTransition *> waiting_list;
 
+    // Attributes fixed during initialization.
+    LocalProblem *owner;
+    vector<LocalTransition> outgoing_transitions;
+
     LocalProblemNode(LocalProblem *owner_, int context_size)
-        : owner(owner_),
+        : generation(-1),
           cost(-1),
           expanded(false),
           context(context_size, -1),
-          reached_by(0) {
+          reached_by(0),
+          owner(owner_) {
     }
 
     ~LocalProblemNode() {
@@ -107,12 +113,14 @@ struct LocalProblemNode {
 };
 
 struct LocalProblem {
+    int generation;
     int base_priority;
     vector<LocalProblemNode> nodes;
     vector<int> *context_variables;
 public:
     LocalProblem()
-        : base_priority(-1) {
+        : generation(-1),
+          base_priority(-1) {
     }
 
     ~LocalProblem() {
@@ -123,15 +131,16 @@ LocalProblem *ContextEnhancedAdditiveHeuristic::get_local_problem(
     int var_no, int value) {
     LocalProblem * &table_entry = local_problem_index[var_no][value];
     if (!table_entry) {
-        table_entry = build_problem_for_variable(var_no);
-        local_problems.push_back(table_entry);
+        local_problems.emplace_back();
+        table_entry = &local_problems.back();
+        build_problem_for_variable(var_no, *table_entry);
     }
     return table_entry;
 }
 
-LocalProblem *ContextEnhancedAdditiveHeuristic::build_problem_for_variable(
-    int var_no) const {
-    LocalProblem *problem = new LocalProblem;
+void ContextEnhancedAdditiveHeuristic::build_problem_for_variable(
+    int var_no, LocalProblem &local_problem) const {
+    LocalProblem *problem = &local_problem;
 
     DomainTransitionGraph *dtg = transition_graphs[var_no].get();
 
@@ -160,11 +169,11 @@ LocalProblem *ContextEnhancedAdditiveHeuristic::build_problem_for_variable(
             }
         }
     }
-    return problem;
 }
 
-LocalProblem *ContextEnhancedAdditiveHeuristic::build_problem_for_goal() const {
-    LocalProblem *problem = new LocalProblem;
+void ContextEnhancedAdditiveHeuristic::build_problem_for_goal(
+    LocalProblem &local_problem) const {
+    LocalProblem *problem = &local_problem;
 
     GoalsProxy goals_proxy = task_proxy.get_goals();
 
@@ -184,7 +193,6 @@ LocalProblem *ContextEnhancedAdditiveHeuristic::build_problem_for_goal() const {
     ValueTransitionLabel *label = new ValueTransitionLabel(0, true, goals, no_effects);
     LocalTransition trans(&problem->nodes[0], &problem->nodes[1], label, 0);
     problem->nodes[0].outgoing_transitions.push_back(trans);
-    return problem;
 }
 
 int ContextEnhancedAdditiveHeuristic::get_priority(
@@ -208,25 +216,51 @@ inline void ContextEnhancedAdditiveHeuristic::add_to_heap(
     node_queue.push(get_priority(node), node);
 }
 
+void ContextEnhancedAdditiveHeuristic::start_new_generation() {
+    if (generation == numeric_limits<int>::max()) {
+        // Avoid overflow by marking everything as outdated explicitly.
+        for (LocalProblem &problem : local_problems) {
+            problem.generation = -1;
+            for (LocalProblemNode &node : problem.nodes)
+                node.generation = -1;
+        }
+        generation = -1;
+    }
+    ++generation;
+}
+
+inline void ContextEnhancedAdditiveHeuristic::reset_node_if_outdated(
+    LocalProblemNode *node) const {
+    /*
+      Nodes are reset lazily when they are first accessed in an
+      evaluation. All nodes are accessed through this method, through
+      the queue or through the reached_by and waiting_list attributes of
+      nodes that have been reset in the current evaluation, so we never
+      see outdated values.
+    */
+    if (node->generation != generation) {
+        node->generation = generation;
+        node->expanded = false;
+        node->cost = numeric_limits<int>::max();
+        node->waiting_list.clear();
+        node->reached_by = 0;
+    }
+}
+
 bool ContextEnhancedAdditiveHeuristic::is_local_problem_set_up(
     const LocalProblem *problem) const {
-    return problem->base_priority != -1;
+    return problem->generation == generation;
 }
 
 void ContextEnhancedAdditiveHeuristic::set_up_local_problem(
     LocalProblem *problem, int base_priority,
     int start_value, const State &state) {
-    assert(problem->base_priority == -1);
+    assert(!is_local_problem_set_up(problem));
+    problem->generation = generation;
     problem->base_priority = base_priority;
 
-    for (auto &to_node : problem->nodes) {
-        to_node.expanded = false;
-        to_node.cost = numeric_limits<int>::max();
-        to_node.waiting_list.clear();
-        to_node.reached_by = 0;
-    }
-
     LocalProblemNode *start = &problem->nodes[start_value];
+    reset_node_if_outdated(start);
     start->cost = 0;
     for (size_t i = 0; i < problem->context_variables->size(); ++i)
         start->context[i] = state[(*problem->context_variables)[i]].get_value();
@@ -287,6 +321,7 @@ void ContextEnhancedAdditiveHeuristic::expand_transition(
 
     trans->target_cost = trans->source->cost + trans->action_cost;
 
+    reset_node_if_outdated(trans->target);
     if (trans->target->cost <= trans->target_cost) {
         // Transition cannot find a shorter path to target.
         return;
@@ -321,6 +356,7 @@ void ContextEnhancedAdditiveHeuristic::expand_transition(
         }
 
         LocalProblemNode *cond_node = &subproblem->nodes[precond_value];
+        reset_node_if_outdated(cond_node);
         if (cond_node->expanded) {
             trans->target_cost += cond_node->cost;
             if (trans->target->cost <= trans->target_cost) {
@@ -395,9 +431,7 @@ int ContextEnhancedAdditiveHeuristic::compute_heuristic(
     const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     initialize_heap();
-    goal_problem->base_priority = -1;
-    for (LocalProblem *problem : local_problems)
-        problem->base_priority = -1;
+    start_new_generation();
 
     set_up_local_problem(goal_problem, 0, 0, state);
 
@@ -412,13 +446,16 @@ int ContextEnhancedAdditiveHeuristic::compute_heuristic(
 ContextEnhancedAdditiveHeuristic::ContextEnhancedAdditiveHeuristic(
     const Options &opts)
     : Heuristic(opts),
-      min_action_cost(task_properties::get_min_operator_cost(task_proxy)) {
+      min_action_cost(task_properties::get_min_operator_cost(task_proxy)),
+      generation(-1) {
     utils::g_log << "Initializing context-enhanced additive heuristic..." << endl;
 
     DTGFactory factory(task_proxy, true, [](int, int) {return false;});
     transition_graphs = factory.build_dtgs();
 
-    goal_problem = build_problem_for_goal();
+    local_problems.emplace_back();
+    goal_problem = &local_problems.back();
+    build_problem_for_goal(*goal_problem);
     goal_node = &goal_problem->nodes[1];
 
     VariablesProxy vars = task_proxy.get_variables();
@@ -428,14 +465,8 @@ ContextEnhancedAdditiveHeuristic::ContextEnhancedAdditiveHeuristic(
 }
 
 ContextEnhancedAdditiveHeuristic::~ContextEnhancedAdditiveHeuristic() {
-    if (goal_problem) {
-        delete goal_problem->context_variables;
-        delete goal_problem->nodes[0].outgoing_transitions[0].label;
-    }
-    delete goal_problem;
-
-    for (LocalProblem *problem : local_problems)
-        delete problem;
+    delete goal_problem->context_variables;
+    delete goal_problem->nodes[0].outgoing_transitions[0].label;
 }
 
 bool ContextEnhancedAdditiveHeuristic::dead_ends_are_reliable() const {
@@ -7,6 +7,7 @@
 
 #include "../algorithms/priority_queues.h"
 
+#include <deque>
 #include <vector>
 
 class State;
@@ -18,22 +19,36 @@ struct LocalTransition;
 
 class ContextEnhancedAdditiveHeuristic : public Heuristic {
     std::vector<std::unique_ptr<domain_transition_graph::DomainTransitionGraph>> transition_graphs;
-    std::vector<LocalProblem *> local_problems;
+    /*
+      Local problems are built lazily and never freed before the
+      heuristic is destroyed, so we allocate them in a deque, which
+      keeps their addresses stable.
+    */
+    std::deque<LocalProblem> local_problems;
     std::vector<std::vector<LocalProblem *>> local_problem_index;
     LocalProblem *goal_problem;
     LocalProblemNode *goal_node;
     int min_action_cost;
+    /*
+      Local problems and nodes are only valid for the evaluation in
+      which they were last set up, which is identified by its
+      generation. This makes resetting all local problems a matter of
+      incrementing the generation.
+    */
+    int generation;
 
     priority_queues::AdaptiveQueue<LocalProblemNode *> node_queue;
 
     LocalProblem *get_local_problem(int var_no, int value);
-    LocalProblem *build_problem_for_variable(int var_no) const;
-    LocalProblem *build_problem_for_goal() const;
+    void build_problem_for_variable(int var_no, LocalProblem &problem) const;
+    void build_problem_for_goal(LocalProblem &problem) const;
 
     int get_priority(LocalProblemNode *node) const;
     void initialize_heap();
     void add_to_heap(LocalProblemNode *node);
 
+    void start_new_generation();
+    void reset_node_if_outdated(LocalProblemNode *node) const;
     bool is_local_problem_set_up(const LocalProblem *problem) const;
     void set_up_local_problem(LocalProblem *problem, int base_priority,
                               int start_value, const State &state);
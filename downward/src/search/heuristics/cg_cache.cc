@@ -13,12 +13,22 @@
 #include <vector>
 
 using namespace std;
+using domain_transition_graph::ValueTransitionLabel;
 
 namespace cg_heuristic {
 const int CGCache::NOT_COMPUTED;
 
-CGCache::CGCache(const TaskProxy &task_proxy, int max_cache_size)
-    : task_proxy(task_proxy) {
+CGCache::CGCache(const TaskProxy &task_proxy, int max_cache_size,
+                 size_t max_hashed_bytes)
+    : task_proxy(task_proxy),
+      table_bytes(0),
+      clock_hand(0),
+      max_hashed_bytes(max_hashed_bytes),
+      hashed_bytes(0),
+      peak_hashed_bytes(0),
+      num_hits(0),
+      num_misses(0),
+      num_evictions(0) {
     utils::g_log << "Initializing heuristic cache... " << flush;
 
     int var_count = task_proxy.get_variables().size();
@@ -54,15 +64,23 @@ CGCache::CGCache(const TaskProxy &task_proxy, int max_cache_size)
 
     cache.resize(var_count);
     helpful_transition_cache.resize(var_count);
+    hashed_rows.resize(var_count);
 
+    int num_hashed_vars = 0;
     for (int var = 0; var < var_count; ++var) {
         int required_cache_size = compute_required_cache_size(
             var, depends_on[var], max_cache_size);
         if (required_cache_size != -1) {
             cache[var].resize(required_cache_size, NOT_COMPUTED);
             helpful_transition_cache[var].resize(required_cache_size, nullptr);
+            table_bytes += required_cache_size *
+                (sizeof(int) + sizeof(ValueTransitionLabel *));
+        } else if (max_hashed_bytes > 0) {
+            ++num_hashed_vars;
         }
     }
+    utils::g_log << "using hash tables for " << num_hashed_vars
+                 << " of " << var_count << " variables... " << flush;
 
     utils::g_log << "done!" << endl;
 }
@@ -86,6 +104,7 @@ int CGCache::compute_required_cache_size(
                                         max_cache_size))
         return -1;
 
+    // Rows (without the diagonal) for all from values and all contexts.
     int required_size = var_domain * (var_domain - 1);
 
     for (int depend_var_id : depends_on) {
@@ -111,20 +130,165 @@ int CGCache::compute_required_cache_size(
     return required_size;
 }
 
-int CGCache::get_index(int var, const State &state,
-                       int from_val, int to_val) const {
-    assert(is_cached(var));
-    assert(from_val != to_val);
+int CGCache::get_index(int var, const State &state, int from_val) const {
+    assert(uses_table(var));
+    int domain_size = task_proxy.get_variables()[var].get_domain_size();
     int index = from_val;
-    int multiplier = task_proxy.get_variables()[var].get_domain_size();
+    int multiplier = domain_size;
     for (int dep_var : depends_on[var]) {
         index += state[dep_var].get_value() * multiplier;
         multiplier *= task_proxy.get_variables()[dep_var].get_domain_size();
     }
-    if (to_val > from_val)
-        --to_val;
-    index += to_val * multiplier;
-    assert(utils::in_bounds(index, cache[var]));
+    index *= domain_size - 1;
+    assert(utils::in_bounds(index + domain_size - 2, cache[var]));
     return index;
 }
+
+CGCache::HashedRow *CGCache::find_hashed_row(
+    int var, const State &state, int from_val) {
+    key.clear();
+    key.push_back(from_val);
+    for (int dep_var : depends_on[var]) {
+        key.push_back(state[dep_var].get_value());
+    }
+    const utils::HashMap<vector<int>, int> &rows = hashed_rows[var];
+    auto it = rows.find(key);
+    if (it == rows.end()) {
+        return nullptr;
+    }
+    return &slots[it->second];
+}
+
+int CGCache::lookup(int var, const State &state, int from_val, int to_val) {
+    assert(from_val != to_val);
+    int cost = NOT_COMPUTED;
+    if (uses_table(var)) {
+        cost = cache[var][
+            get_index(var, state, from_val) + get_column(from_val, to_val)];
+    } else if (max_hashed_bytes > 0) {
+        HashedRow *row = find_hashed_row(var, state, from_val);
+        if (row) {
+            row->referenced = true;
+            cost = row->distances[to_val];
+        }
+    }
+    if (cost == NOT_COMPUTED) {
+        ++num_misses;
+    } else {
+        ++num_hits;
+    }
+    return cost;
+}
+
+bool CGCache::lookup_helpful_transition(
+    int var, const State &state, int from_val, int to_val, int &cost,
+    ValueTransitionLabel *&helpful_transition) {
+    assert(from_val != to_val);
+    if (uses_table(var)) {
+        int index = get_index(var, state, from_val) +
+            get_column(from_val, to_val);
+        cost = cache[var][index];
+        helpful_transition = helpful_transition_cache[var][index];
+    } else if (max_hashed_bytes > 0) {
+        HashedRow *row = find_hashed_row(var, state, from_val);
+        if (!row) {
+            return false;
+        }
+        cost = row->distances[to_val];
+        helpful_transition = row->helpful_transitions[to_val];
+    } else {
+        return false;
+    }
+    return cost != NOT_COMPUTED;
+}
+
+void CGCache::evict(int slot) {
+    HashedRow &row = slots[slot];
+    assert(row.var != -1);
+    hashed_rows[row.var].erase(*row.key);
+    hashed_bytes -= row.bytes;
+    row.var = -1;
+    row.key = nullptr;
+    utils::release_vector_memory(row.distances);
+    utils::release_vector_memory(row.helpful_transitions);
+    free_slots.push_back(slot);
+    ++num_evictions;
+}
+
+void CGCache::make_room(size_t bytes) {
+    while (hashed_bytes + bytes > max_hashed_bytes) {
+        assert(hashed_bytes > 0);
+        if (clock_hand >= slots.size()) {
+            clock_hand = 0;
+        }
+        HashedRow &row = slots[clock_hand];
+        if (row.var != -1) {
+            if (row.referenced) {
+                row.referenced = false;
+            } else {
+                evict(clock_hand);
+            }
+        }
+        ++clock_hand;
+    }
+}
+
+void CGCache::store(
+    int var, const State &state, int from_val,
+    const vector<int> &distances,
+    const vector<ValueTransitionLabel *> &helpful_transitions) {
+    int num_values = distances.size();
+    if (uses_table(var)) {
+        int index = get_index(var, state, from_val);
+        for (int val = 0; val < num_values; ++val) {
+            if (val != from_val) {
+                int column = index + get_column(from_val, val);
+                cache[var][column] = distances[val];
+                helpful_transition_cache[var][column] = helpful_transitions[val];
+            }
+        }
+        return;
+    }
+    if (max_hashed_bytes == 0 || find_hashed_row(var, state, from_val)) {
+        return;
+    }
+
+    // Estimate of the memory for the row, its key and the hash table entry.
+    size_t bytes = sizeof(HashedRow) + 2 * key.size() * sizeof(int) +
+        num_values * (sizeof(int) + sizeof(ValueTransitionLabel *)) +
+        4 * sizeof(void *);
+    if (bytes > max_hashed_bytes) {
+        return;
+    }
+    make_room(bytes);
+
+    int slot;
+    if (free_slots.empty()) {
+        slot = slots.size();
+        slots.emplace_back();
+    } else {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    auto result = hashed_rows[var].emplace(key, slot);
+    assert(result.second);
+    HashedRow &row = slots[slot];
+    row.var = var;
+    row.key = &result.first->first;
+    row.distances = distances;
+    row.helpful_transitions = helpful_transitions;
+    row.referenced = true;
+    row.bytes = bytes;
+    hashed_bytes += bytes;
+    peak_hashed_bytes = max(peak_hashed_bytes, hashed_bytes);
+}
+
+void CGCache::print_statistics() const {
+    utils::g_log << "CG cache hits: " << num_hits << endl;
+    utils::g_log << "CG cache misses: " << num_misses << endl;
+    utils::g_log << "CG cache evictions: " << num_evictions << endl;
+    utils::g_log << "CG cache table memory: " << table_bytes / 1024 << " KB" << endl;
+    utils::g_log << "CG cache hash table memory: " << hashed_bytes / 1024
+                 << " KB (peak: " << peak_hashed_bytes / 1024 << " KB)" << endl;
+}
 }
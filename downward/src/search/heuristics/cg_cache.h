@@ -3,6 +3,9 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/hash.h"
+
+#include <cstddef>
 #include <vector>
 
 namespace domain_transition_graph {
@@ -10,46 +13,95 @@ struct ValueTransitionLabel;
 }
 
 namespace cg_heuristic {
+/*
+  Cache for the transition costs computed by the causal graph heuristic.
+  The costs of the transitions of a variable only depend on the values of
+  the variables it (transitively) depends on in the reduced causal graph,
+  its context. The cache stores rows of costs and helpful transitions
+  from one value to all other values for a given context.
+
+  For variables whose table of all contexts fits into max_cache_size
+  entries, the rows are stored in a preallocated table. For all other
+  variables, rows are stored in hash tables (one per variable) that
+  share a memory budget. When the budget is exhausted, rows are evicted
+  according to the clock (second chance) policy. Evicted rows are simply
+  recomputed when needed again.
+*/
 class CGCache {
+    struct HashedRow {
+        // -1 for unused slots
+        int var;
+        // Points to the key of the row in hashed_rows[var].
+        const std::vector<int> *key;
+        std::vector<int> distances;
+        std::vector<domain_transition_graph::ValueTransitionLabel *> helpful_transitions;
+        bool referenced;
+        std::size_t bytes;
+    };
+
     TaskProxy task_proxy;
     std::vector<std::vector<int>> cache;
     std::vector<std::vector<domain_transition_graph::ValueTransitionLabel *>> helpful_transition_cache;
     std::vector<std::vector<int>> depends_on;
+    std::size_t table_bytes;
+
+    // Maps (from value, context) to the slot of the row.
+    std::vector<utils::HashMap<std::vector<int>, int>> hashed_rows;
+    std::vector<HashedRow> slots;
+    std::vector<int> free_slots;
+    std::size_t clock_hand;
+    const std::size_t max_hashed_bytes;
+    std::size_t hashed_bytes;
+    std::size_t peak_hashed_bytes;
+    std::vector<int> key;
 
-    int get_index(int var, const State &state, int from_val, int to_val) const;
+    long long num_hits;
+    long long num_misses;
+    long long num_evictions;
+
+    int get_index(int var, const State &state, int from_val) const;
+    // Rows of the tables leave out the diagonal (from_val == to_val).
+    static int get_column(int from_val, int to_val) {
+        return to_val > from_val ? to_val - 1 : to_val;
+    }
     int compute_required_cache_size(
         int var_id, const std::vector<int> &depends_on, int max_cache_size) const;
+
+    bool uses_table(int var) const {
+        return !cache[var].empty();
+    }
+    HashedRow *find_hashed_row(int var, const State &state, int from_val);
+    void evict(int slot);
+    void make_room(std::size_t bytes);
 public:
     static const int NOT_COMPUTED = -2;
 
-    CGCache(const TaskProxy &task_proxy, int max_cache_size);
+    CGCache(const TaskProxy &task_proxy, int max_cache_size,
+            std::size_t max_hashed_bytes);
     ~CGCache();
 
     bool is_cached(int var) const {
-        return !cache[var].empty();
+        return uses_table(var) || max_hashed_bytes > 0;
     }
 
-    int lookup(int var, const State &state, int from_val, int to_val) const {
-        return cache[var][get_index(var, state, from_val, to_val)];
-    }
+    // Return the cached cost or NOT_COMPUTED and count hits and misses.
+    int lookup(int var, const State &state, int from_val, int to_val);
 
-    void store(int var, const State &state,
-               int from_val, int to_val, int cost) {
-        cache[var][get_index(var, state, from_val, to_val)] = cost;
-    }
+    /*
+      Look up the cost and helpful transition for a transition whose
+      cost has been stored for the given state. Return false if the row
+      has been evicted since.
+    */
+    bool lookup_helpful_transition(
+        int var, const State &state, int from_val, int to_val, int &cost,
+        domain_transition_graph::ValueTransitionLabel *&helpful_transition);
 
-    domain_transition_graph::ValueTransitionLabel *lookup_helpful_transition(
-        int var, const State &state, int from_val, int to_val) const {
-        int index = get_index(var, state, from_val, to_val);
-        return helpful_transition_cache[var][index];
-    }
+    void store(
+        int var, const State &state, int from_val,
+        const std::vector<int> &distances,
+        const std::vector<domain_transition_graph::ValueTransitionLabel *> &helpful_transitions);
 
-    void store_helpful_transition(
-        int var, const State &state, int from_val, int to_val,
-        domain_transition_graph::ValueTransitionLabel *helpful_transition) {
-        int index = get_index(var, state, from_val, to_val);
-        helpful_transition_cache[var][index] = helpful_transition;
-    }
+    void print_statistics() const;
 };
 }
 
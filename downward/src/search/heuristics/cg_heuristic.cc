@@ -20,15 +20,16 @@ using namespace domain_transition_graph;
 namespace cg_heuristic {
 CGHeuristic::CGHeuristic(const Options &opts)
     : Heuristic(opts),
-      cache_hits(0),
-      cache_misses(0),
       helpful_transition_extraction_counter(0),
       min_action_cost(task_properties::get_min_operator_cost(task_proxy)) {
     utils::g_log << "Initializing causal graph heuristic..." << endl;
 
     int max_cache_size = opts.get<int>("max_cache_size");
+    size_t max_hashed_cache_bytes =
+        static_cast<size_t>(opts.get<int>("hashed_cache_memory")) * 1024 * 1024;
     if (max_cache_size > 0)
-        cache = utils::make_unique_ptr<CGCache>(task_proxy, max_cache_size);
+        cache = utils::make_unique_ptr<CGCache>(
+            task_proxy, max_cache_size, max_hashed_cache_bytes);
 
     unsigned int num_vars = task_proxy.get_variables().size();
     prio_queues.reserve(num_vars);
@@ -44,6 +45,11 @@ CGHeuristic::CGHeuristic(const Options &opts)
 CGHeuristic::~CGHeuristic() {
 }
 
+void CGHeuristic::print_statistics() const {
+    if (cache)
+        cache->print_statistics();
+}
+
 bool CGHeuristic::dead_ends_are_reliable() const {
     return false;
 }
@@ -93,12 +99,8 @@ int CGHeuristic::get_transition_cost(const State &state,
     bool use_the_cache = cache && cache->is_cached(var_no);
     if (use_the_cache) {
         int cached_val = cache->lookup(var_no, state, start_val, goal_val);
-        if (cached_val != CGCache::NOT_COMPUTED) {
-            ++cache_hits;
+        if (cached_val != CGCache::NOT_COMPUTED)
             return cached_val;
-        }
-    } else {
-        ++cache_misses;
     }
 
     ValueNode *start = &dtg->nodes[start_val];
@@ -204,18 +206,18 @@ int CGHeuristic::get_transition_cost(const State &state,
     }
 
     if (use_the_cache) {
+#ifndef NDEBUG
         int num_values = start->distances.size();
         for (int val = 0; val < num_values; ++val) {
             if (val == start_val)
                 continue;
-            int distance = start->distances[val];
-            ValueTransitionLabel *helpful = start->helpful_transitions[val];
             // We should have a helpful transition iff distance is infinite.
-            assert((distance == numeric_limits<int>::max()) == !helpful);
-            cache->store(var_no, state, start_val, val, distance);
-            cache->store_helpful_transition(
-                var_no, state, start_val, val, helpful);
+            assert((start->distances[val] == numeric_limits<int>::max()) ==
+                   !start->helpful_transitions[val]);
         }
+#endif
+        cache->store(var_no, state, start_val,
+                     start->distances, start->helpful_transitions);
     }
 
     return start->distances[goal_val];
@@ -255,12 +257,19 @@ void CGHeuristic::mark_helpful_transitions(const State &state,
     ValueTransitionLabel *helpful;
     int cost;
     // Check cache.
-    if (cache && cache->is_cached(var_no)) {
-        helpful = cache->lookup_helpful_transition(var_no, state, from, to);
-        cost = cache->lookup(var_no, state, from, to);
+    if (cache && cache->is_cached(var_no) &&
+        cache->lookup_helpful_transition(var_no, state, from, to, cost, helpful)) {
         assert(helpful);
     } else {
         ValueNode *start_node = &dtg->nodes[from];
+        if (start_node->helpful_transitions.empty()) {
+            /*
+              The cost was taken from the cache, but the row has been
+              evicted since. Recompute it.
+            */
+            assert(cache && cache->is_cached(var_no));
+            get_transition_cost(state, dtg, from, to);
+        }
         assert(!start_node->helpful_transitions.empty());
         helpful = start_node->helpful_transitions[to];
         cost = start_node->distances[to];
@@ -304,6 +313,14 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "maximum number of cached entries per variable (set to 0 to disable cache)",
         "1000000",
         Bounds("0", "infinity"));
+    parser.add_option<int>(
+        "hashed_cache_memory",
+        "memory budget in MiB shared by the hash tables that cache the "
+        "variables which need more than max_cache_size entries. When the "
+        "budget is exhausted, entries are evicted with the clock policy. "
+        "Set to 0 to disable caching for these variables.",
+        "64",
+        Bounds("0", "infinity"));
 
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
@@ -23,8 +23,6 @@ class CGHeuristic : public Heuristic {
     std::vector<std::unique_ptr<domain_transition_graph::DomainTransitionGraph>> transition_graphs;
 
     std::unique_ptr<CGCache> cache;
-    int cache_hits;
-    int cache_misses;
 
     int helpful_transition_extraction_counter;
 
@@ -46,6 +44,7 @@ public:
     explicit CGHeuristic(const options::Options &opts);
     ~CGHeuristic();
     virtual bool dead_ends_are_reliable() const override;
+    virtual void print_statistics() const override;
 };
 }
 
@@ -4,25 +4,65 @@
 #include "../plugin.h"
 
 #include "../task_utils/task_properties.h"
+#include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/system.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iostream>
 #include <limits>
-#include <set>
 
 using namespace std;
 
 namespace hm_heuristic {
+const int HMHeuristic::INFTY = numeric_limits<int>::max();
+const int HMHeuristic::NO_VALUE_CONSTRAINT;
+const int HMHeuristic::BLOCKED_VARIABLE;
+
 HMHeuristic::HMHeuristic(const Options &opts)
     : Heuristic(opts),
       m(opts.get<int>("m")),
+      semi_naive(opts.get<bool>("semi_naive")),
       has_cond_effects(task_properties::has_conditional_effects(task_proxy)),
-      goals(task_properties::get_fact_pairs(task_proxy.get_goals())) {
+      was_updated(false),
+      process_all_next_round(false) {
     utils::g_log << "Using h^" << m << "." << endl;
-    utils::g_log << "The implementation of the h^m heuristic is preliminary." << endl
-                 << "It is SLOOOOOOOOOOOW." << endl
-                 << "Please do not use this for comparison!" << endl;
-    generate_all_tuples();
+    utils::g_log << "The implementation of the h^m heuristic is preliminary." << endl;
+
+    VariablesProxy variables = task_proxy.get_variables();
+    int num_facts = 0;
+    for (VariableProxy var : variables) {
+        fact_offsets.push_back(num_facts);
+        for (int value = 0; value < var.get_domain_size(); ++value)
+            fact_vars.push_back(var.get_id());
+        num_facts += var.get_domain_size();
+    }
+    fact_offsets.push_back(num_facts);
+
+    goals = get_sorted_facts(
+        task_properties::get_fact_pairs(task_proxy.get_goals()));
+
+    OperatorsProxy ops = task_proxy.get_operators();
+    precondition_of.resize(num_facts);
+    operators.reserve(ops.size());
+    for (OperatorProxy op : ops) {
+        HMOperator hm_op;
+        hm_op.preconditions = get_sorted_facts(
+            task_properties::get_fact_pairs(op.get_preconditions()));
+        vector<FactPair> effects;
+        for (EffectProxy eff : op.get_effects())
+            effects.push_back(eff.get_fact().get_pair());
+        hm_op.effects = get_sorted_facts(effects);
+        hm_op.cost = op.get_cost();
+        for (int fact : hm_op.preconditions)
+            precondition_of[fact].push_back(op.get_id());
+        operators.push_back(move(hm_op));
+    }
+
+    build_tuple_index();
+    var_constraints.assign(variables.size(), NO_VALUE_CONSTRAINT);
+    process_next_round.assign(operators.size(), false);
 }
 
 
@@ -31,233 +71,279 @@ bool HMHeuristic::dead_ends_are_reliable() const {
 }
 
 
-int HMHeuristic::compute_heuristic(const State &ancestor_state) {
-    State state = convert_ancestor_state(ancestor_state);
-    if (task_properties::is_goal_state(task_proxy, state)) {
-        return 0;
-    } else {
-        Tuple s_tup = task_properties::get_fact_pairs(state);
+vector<int> HMHeuristic::get_sorted_facts(const vector<FactPair> &facts) const {
+    vector<int> result;
+    result.reserve(facts.size());
+    for (const FactPair &fact : facts)
+        result.push_back(get_fact(fact));
+    utils::sort_unique(result);
+    return result;
+}
 
-        init_hm_table(s_tup);
-        update_hm_table();
 
-        int h = eval(goals);
+void HMHeuristic::build_tuple_index() {
+    int num_facts = fact_offsets.back();
+    max_tuple_size = min<int>(m, task_proxy.get_variables().size());
+    const size_t max_size = hm_table.max_size();
+
+    // Binomial coefficients larger than max_size are clamped to max_size.
+    binomials.assign(num_facts + 1, vector<size_t>(max_tuple_size + 1, 0));
+    for (int n = 0; n <= num_facts; ++n) {
+        binomials[n][0] = 1;
+        for (int k = 1; k <= min(n, max_tuple_size); ++k) {
+            size_t value = binomials[n - 1][k - 1];
+            if (k < n)
+                value += binomials[n - 1][k];
+            binomials[n][k] = min(value, max_size);
+        }
+    }
 
-        if (h == numeric_limits<int>::max())
-            return DEAD_END;
-        return h;
+    tuple_offsets.assign(max_tuple_size + 2, 0);
+    for (int k = 1; k <= max_tuple_size; ++k) {
+        size_t num_tuples = binomials[num_facts][k];
+        if (num_tuples >= max_size - tuple_offsets[k]) {
+            cerr << "The h^" << m << " table is too large." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+        }
+        tuple_offsets[k + 1] = tuple_offsets[k] + num_tuples;
     }
+    hm_table.resize(tuple_offsets[max_tuple_size + 1]);
+    utils::g_log << "Size of h^" << m << " table: " << hm_table.size() << endl;
 }
 
 
-void HMHeuristic::init_hm_table(const Tuple &t) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        int h_val = check_tuple_in_tuple(tuple, t);
-        hm_table[tuple] = h_val;
+size_t HMHeuristic::get_index(const vector<int> &tuple) const {
+    assert(!tuple.empty() && static_cast<int>(tuple.size()) <= max_tuple_size);
+    size_t index = tuple_offsets[tuple.size()];
+    for (size_t i = 0; i < tuple.size(); ++i) {
+        assert(i == 0 || tuple[i - 1] < tuple[i]);
+        index += binomials[tuple[i]][i + 1];
     }
+    return index;
 }
 
 
-void HMHeuristic::update_hm_table() {
-    int round = 0;
-    do {
-        ++round;
-        was_updated = false;
-
-        for (OperatorProxy op : task_proxy.get_operators()) {
-            Tuple pre = get_operator_pre(op);
-
-            int c1 = eval(pre);
-            if (c1 != numeric_limits<int>::max()) {
-                Tuple eff = get_operator_eff(op);
-                vector<Tuple> partial_effs;
-                generate_all_partial_tuples(eff, partial_effs);
-                for (Tuple &partial_eff : partial_effs) {
-                    update_hm_entry(partial_eff, c1 + op.get_cost());
-
-                    int eff_size = partial_eff.size();
-                    if (eff_size < m) {
-                        extend_tuple(partial_eff, op);
-                    }
-                }
-            }
-        }
-    } while (was_updated);
+/*
+  Call callback(index, subtuple) for all subtuples of the given sorted
+  tuple with at most m facts and no two facts of the same variable.
+*/
+template<class Callback>
+void HMHeuristic::for_each_subtuple(
+    const vector<int> &tuple, size_t first, size_t rank,
+    vector<int> &current, const Callback &callback) const {
+    size_t size = current.size();
+    for (size_t i = first; i < tuple.size(); ++i) {
+        int fact = tuple[i];
+        /*
+          The tuple is sorted, so all facts between two facts of the
+          same variable also belong to this variable.
+        */
+        if (!current.empty() && fact_vars[current.back()] == fact_vars[fact])
+            continue;
+        size_t new_rank = rank + binomials[fact][size + 1];
+        current.push_back(fact);
+        callback(tuple_offsets[size + 1] + new_rank, current);
+        if (static_cast<int>(size) + 1 < m)
+            for_each_subtuple(tuple, i + 1, new_rank, current, callback);
+        current.pop_back();
+    }
 }
 
 
-void HMHeuristic::extend_tuple(const Tuple &t, const OperatorProxy &op) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        bool contradict = false;
-        for (const FactPair &fact : tuple) {
-            if (contradict_effect_of(op, fact.var, fact.value)) {
-                contradict = true;
-                break;
-            }
-        }
-        if (!contradict && (tuple.size() > t.size()) && (check_tuple_in_tuple(t, tuple) == 0)) {
-            Tuple pre = get_operator_pre(op);
-
-            Tuple others;
-            for (const FactPair &fact : tuple) {
-                if (find(t.begin(), t.end(), fact) == t.end()) {
-                    others.push_back(fact);
-                    if (find(pre.begin(), pre.end(), fact) == pre.end()) {
-                        pre.push_back(fact);
-                    }
-                }
-            }
+int HMHeuristic::compute_heuristic(const State &ancestor_state) {
+    State state = convert_ancestor_state(ancestor_state);
+    if (task_properties::is_goal_state(task_proxy, state)) {
+        return 0;
+    } else {
+        vector<int> state_facts = get_sorted_facts(
+            task_properties::get_fact_pairs(state));
 
-            sort(pre.begin(), pre.end());
+        init_hm_table(state_facts);
+        update_hm_table();
 
-            set<int> vars;
-            bool is_valid = true;
-            for (const FactPair &fact : pre) {
-                if (vars.count(fact.var) != 0) {
-                    is_valid = false;
-                    break;
-                }
-                vars.insert(fact.var);
-            }
+        int h = eval(goals);
 
-            if (is_valid) {
-                int c2 = eval(pre);
-                if (c2 != numeric_limits<int>::max()) {
-                    update_hm_entry(tuple, c2 + op.get_cost());
-                }
-            }
-        }
+        if (h == INFTY)
+            return DEAD_END;
+        return h;
     }
 }
 
 
-int HMHeuristic::eval(const Tuple &t) const {
-    vector<Tuple> partial;
-    generate_all_partial_tuples(t, partial);
-    int max = 0;
-    for (Tuple &tuple : partial) {
-        assert(hm_table.count(tuple) == 1);
-
-        int h = hm_table.at(tuple);
-        if (h > max) {
-            max = h;
-        }
-    }
-    return max;
+void HMHeuristic::init_hm_table(const vector<int> &state_facts) {
+    fill(hm_table.begin(), hm_table.end(), INFTY);
+    for_each_subtuple(state_facts, 0, 0, subtuple,
+                      [this](size_t index, const vector<int> &) {
+                          hm_table[index] = 0;
+                      });
 }
 
 
-int HMHeuristic::update_hm_entry(const Tuple &t, int val) {
-    assert(hm_table.count(t) == 1);
-    if (hm_table[t] > val) {
-        hm_table[t] = val;
-        was_updated = true;
+void HMHeuristic::update_hm_table() {
+    int num_ops = operators.size();
+    if (!semi_naive) {
+        do {
+            was_updated = false;
+            for (const HMOperator &op : operators)
+                process_operator(op);
+        } while (was_updated);
+        return;
     }
-    return val;
-}
-
 
-int HMHeuristic::check_tuple_in_tuple(
-    const Tuple &tuple, const Tuple &big_tuple) const {
-    for (const FactPair &fact0 : tuple) {
-        bool found = false;
-        for (auto &fact1 : big_tuple) {
-            if (fact0 == fact1) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            return numeric_limits<int>::max();
+    vector<int> current_round;
+    process_all_next_round = true;
+    while (true) {
+        current_round.clear();
+        for (int op_id = 0; op_id < num_ops; ++op_id) {
+            if (process_all_next_round || process_next_round[op_id])
+                current_round.push_back(op_id);
         }
+        if (current_round.empty())
+            break;
+        fill(process_next_round.begin(), process_next_round.end(), false);
+        process_all_next_round = false;
+        for (int op_id : current_round)
+            process_operator(operators[op_id]);
     }
-    return 0;
 }
 
 
-HMHeuristic::Tuple HMHeuristic::get_operator_pre(const OperatorProxy &op) const {
-    Tuple preconditions = task_properties::get_fact_pairs(op.get_preconditions());
-    sort(preconditions.begin(), preconditions.end());
-    return preconditions;
-}
-
+void HMHeuristic::process_operator(const HMOperator &op) {
+    int c1 = eval(op.preconditions);
+    if (c1 != INFTY) {
+        for_each_subtuple(
+            op.effects, 0, 0, subtuple,
+            [this, &op, c1](size_t index, const vector<int> &partial_eff) {
+                update_hm_entry(index, partial_eff, c1 + op.cost);
 
-HMHeuristic::Tuple HMHeuristic::get_operator_eff(const OperatorProxy &op) const {
-    Tuple effects;
-    for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(eff.get_fact().get_pair());
+                int eff_size = partial_eff.size();
+                if (eff_size < m) {
+                    extend_tuple(partial_eff, op);
+                }
+            });
     }
-    sort(effects.begin(), effects.end());
-    return effects;
 }
 
 
-bool HMHeuristic::contradict_effect_of(
-    const OperatorProxy &op, int var, int val) const {
-    for (EffectProxy eff : op.get_effects()) {
-        FactProxy fact = eff.get_fact();
-        if (fact.get_variable().get_id() == var && fact.get_value() != val) {
-            return true;
-        }
+/*
+  Update the entries of all tuples that extend the given partial effect
+  of op by facts that op does not delete, using the preconditions of op
+  extended by the same facts. The added facts may not belong to the
+  variables of the partial effect and must be consistent with the
+  preconditions of op.
+*/
+void HMHeuristic::extend_tuple(const vector<int> &tuple, const HMOperator &op) {
+    for (int fact : op.preconditions)
+        var_constraints[fact_vars[fact]] = fact;
+    for (int fact : op.effects) {
+        int &constraint = var_constraints[fact_vars[fact]];
+        if (constraint == NO_VALUE_CONSTRAINT || constraint == fact)
+            constraint = fact;
+        else
+            constraint = BLOCKED_VARIABLE;
     }
-    return false;
-}
+    for (int fact : tuple)
+        var_constraints[fact_vars[fact]] = BLOCKED_VARIABLE;
 
+    assert(others.empty());
+    extend_tuple_aux(tuple, op, 0);
 
-void HMHeuristic::generate_all_tuples() {
-    Tuple t;
-    generate_all_tuples_aux(0, m, t);
+    for (int fact : op.preconditions)
+        var_constraints[fact_vars[fact]] = NO_VALUE_CONSTRAINT;
+    for (int fact : op.effects)
+        var_constraints[fact_vars[fact]] = NO_VALUE_CONSTRAINT;
 }
 
 
-void HMHeuristic::generate_all_tuples_aux(int var, int sz, const Tuple &base) {
-    int num_variables = task_proxy.get_variables().size();
-    for (int i = var; i < num_variables; ++i) {
-        int domain_size = task_proxy.get_variables()[i].get_domain_size();
-        for (int j = 0; j < domain_size; ++j) {
-            Tuple tuple(base);
-            tuple.emplace_back(i, j);
-            hm_table[tuple] = 0;
-            if (sz > 1) {
-                generate_all_tuples_aux(i + 1, sz - 1, tuple);
+void HMHeuristic::extend_tuple_aux(
+    const vector<int> &tuple, const HMOperator &op, int first_var) {
+    int num_vars = var_constraints.size();
+    for (int var = first_var; var < num_vars; ++var) {
+        int constraint = var_constraints[var];
+        if (constraint == BLOCKED_VARIABLE)
+            continue;
+        int first_fact = fact_offsets[var];
+        int last_fact = fact_offsets[var + 1];
+        if (constraint != NO_VALUE_CONSTRAINT) {
+            first_fact = constraint;
+            last_fact = constraint + 1;
+        }
+        for (int fact = first_fact; fact < last_fact; ++fact) {
+            others.push_back(fact);
+
+            extended_tuple.clear();
+            merge(tuple.begin(), tuple.end(), others.begin(), others.end(),
+                  back_inserter(extended_tuple));
+            extended_pre.clear();
+            set_union(op.preconditions.begin(), op.preconditions.end(),
+                      others.begin(), others.end(),
+                      back_inserter(extended_pre));
+            int c2 = eval(extended_pre);
+            if (c2 != INFTY) {
+                update_hm_entry(get_index(extended_tuple), extended_tuple,
+                                c2 + op.cost);
             }
+
+            if (static_cast<int>(extended_tuple.size()) < m)
+                extend_tuple_aux(tuple, op, var + 1);
+            others.pop_back();
         }
     }
 }
 
 
-void HMHeuristic::generate_all_partial_tuples(
-    const Tuple &base_tuple, vector<Tuple> &res) const {
-    Tuple t;
-    generate_all_partial_tuples_aux(base_tuple, t, 0, m, res);
+int HMHeuristic::eval(const vector<int> &tuple) {
+    int result = 0;
+    for_each_subtuple(tuple, 0, 0, eval_subtuple,
+                      [this, &result](size_t index, const vector<int> &) {
+                          result = max(result, hm_table[index]);
+                      });
+    return result;
 }
 
 
-void HMHeuristic::generate_all_partial_tuples_aux(
-    const Tuple &base_tuple, const Tuple &t, int index, int sz, vector<Tuple> &res) const {
-    if (sz == 1) {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
-        }
-    } else {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
-            generate_all_partial_tuples_aux(base_tuple, tuple, i + 1, sz - 1, res);
-        }
+void HMHeuristic::update_hm_entry(size_t index, const vector<int> &tuple, int val) {
+    if (hm_table[index] > val) {
+        hm_table[index] = val;
+        was_updated = true;
+        mark_dependent_operators(tuple);
     }
 }
 
 
-void HMHeuristic::dump_table() const {
-    for (auto &hm_ent : hm_table) {
-        utils::g_log << "h(" << hm_ent.first << ") = " << hm_ent.second << endl;
+/*
+  The values computed for an operator only depend on tuples that have
+  at most m - 1 facts outside of its preconditions.
+*/
+void HMHeuristic::mark_dependent_operators(const vector<int> &tuple) {
+    if (!semi_naive || process_all_next_round)
+        return;
+    if (static_cast<int>(tuple.size()) < m) {
+        process_all_next_round = true;
+        return;
     }
+    for (int fact : tuple) {
+        for (int op_id : precondition_of[fact])
+            process_next_round[op_id] = true;
+    }
+}
+
+
+void HMHeuristic::dump_table() const {
+    vector<int> all_facts(fact_offsets.back());
+    for (size_t fact = 0; fact < all_facts.size(); ++fact)
+        all_facts[fact] = fact;
+    vector<int> tuple;
+    for_each_subtuple(
+        all_facts, 0, 0, tuple,
+        [this](size_t index, const vector<int> &facts) {
+            vector<FactPair> fact_pairs;
+            for (int fact : facts) {
+                int var = fact_vars[fact];
+                fact_pairs.emplace_back(var, fact - fact_offsets[var]);
+            }
+            utils::g_log << "h(" << fact_pairs << ") = " << hm_table[index] << endl;
+        });
 }
 
 
@@ -278,6 +364,11 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("preferred operators", "no");
 
     parser.add_option<int>("m", "subset size", "2", Bounds("1", "infinity"));
+    parser.add_option<bool>(
+        "semi_naive",
+        "only reprocess the operators affected by the table entries that "
+        "changed in the previous round of the fixpoint iteration",
+        "true");
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
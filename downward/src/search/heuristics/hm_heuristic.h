@@ -3,10 +3,7 @@
 
 #include "../heuristic.h"
 
-#include <algorithm>
-#include <iostream>
-#include <map>
-#include <string>
+#include <cstddef>
 #include <vector>
 
 namespace options {
@@ -17,43 +14,92 @@ namespace hm_heuristic {
 /*
   Haslum's h^m heuristic family ("critical path heuristics").
 
-  This is a very slow implementation and should not be used for
-  speed benchmarks.
+  Facts are numbered consecutively (all values of variable 0, then all
+  values of variable 1, ...), and tuples are sorted vectors of fact
+  numbers of size at most m. A tuple is stored at its rank in the
+  combinatorial number system, offset by the number of smaller tuples,
+  so the h^m table is a flat vector and looking up a tuple only takes a
+  few additions. (The table also has entries for tuples with two facts
+  of the same variable; these are never accessed.)
+
+  The table is computed with a Bellman-Ford style fixpoint iteration
+  over the operators. In the semi-naive variant, every round after the
+  first only processes the operators that depend on an entry that
+  changed in the previous round.
+
+  The table has sum_{k=1}^{m} (F choose k) entries for F facts, so
+  this is only feasible for small m.
 */
-
 class HMHeuristic : public Heuristic {
-    using Tuple = std::vector<FactPair>;
+    static const int INFTY;
+    static const int NO_VALUE_CONSTRAINT = -1;
+    static const int BLOCKED_VARIABLE = -2;
+
+    struct HMOperator {
+        std::vector<int> preconditions;
+        std::vector<int> effects;
+        int cost;
+    };
+
     // parameters
     const int m;
+    const bool semi_naive;
     const bool has_cond_effects;
 
-    const Tuple goals;
+    // fact_offsets[var]: first fact of var; fact_offsets.back(): number of facts
+    std::vector<int> fact_offsets;
+    std::vector<int> fact_vars;
+    std::vector<int> goals;
+    std::vector<HMOperator> operators;
+    // precondition_of[fact]: operators with this fact as precondition
+    std::vector<std::vector<int>> precondition_of;
+
+    // Tuples cannot be larger than the number of variables.
+    int max_tuple_size;
+    // binomials[n][k] = (n choose k) for n <= number of facts, k <= max_tuple_size
+    std::vector<std::vector<std::size_t>> binomials;
+    // tuple_offsets[k]: index of the first tuple of size k
+    std::vector<std::size_t> tuple_offsets;
 
     // h^m table
-    std::map<Tuple, int> hm_table;
+    std::vector<int> hm_table;
     bool was_updated;
 
-    // auxiliary methods
-    void init_hm_table(const Tuple &t);
-    void update_hm_table();
-    int eval(const Tuple &t) const;
-    int update_hm_entry(const Tuple &t, int val);
-    void extend_tuple(const Tuple &t, const OperatorProxy &op);
+    // Operators to process in the next round of the semi-naive variant.
+    std::vector<bool> process_next_round;
+    bool process_all_next_round;
+
+    // Scratch space for processing an operator.
+    std::vector<int> var_constraints;
+    std::vector<int> extended_tuple;
+    std::vector<int> extended_pre;
+    std::vector<int> others;
+    std::vector<int> subtuple;
+    std::vector<int> eval_subtuple;
 
-    int check_tuple_in_tuple(const Tuple &tuple, const Tuple &big_tuple) const;
+    int get_fact(const FactPair &fact) const {
+        return fact_offsets[fact.var] + fact.value;
+    }
+    std::vector<int> get_sorted_facts(const std::vector<FactPair> &facts) const;
 
-    int get_operator_pre_value(const OperatorProxy &op, int var) const;
-    Tuple get_operator_pre(const OperatorProxy &op) const;
-    Tuple get_operator_eff(const OperatorProxy &op) const;
-    bool contradict_effect_of(const OperatorProxy &op, int var, int val) const;
+    void build_tuple_index();
+    std::size_t get_index(const std::vector<int> &tuple) const;
 
-    void generate_all_tuples();
-    void generate_all_tuples_aux(int var, int sz, const Tuple &base);
+    template<class Callback>
+    void for_each_subtuple(
+        const std::vector<int> &tuple, std::size_t first, std::size_t rank,
+        std::vector<int> &current, const Callback &callback) const;
 
-    void generate_all_partial_tuples(const Tuple &base_tuple,
-                                     std::vector<Tuple> &res) const;
-    void generate_all_partial_tuples_aux(const Tuple &base_tuple, const Tuple &t, int index,
-                                         int sz, std::vector<Tuple> &res) const;
+    // auxiliary methods
+    void init_hm_table(const std::vector<int> &state_facts);
+    void update_hm_table();
+    void process_operator(const HMOperator &op);
+    int eval(const std::vector<int> &tuple);
+    void update_hm_entry(std::size_t index, const std::vector<int> &tuple, int val);
+    void mark_dependent_operators(const std::vector<int> &tuple);
+    void extend_tuple(const std::vector<int> &tuple, const HMOperator &op);
+    void extend_tuple_aux(
+        const std::vector<int> &tuple, const HMOperator &op, int var);
 
     void dump_table() const;
 
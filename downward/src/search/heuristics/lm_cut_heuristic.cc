@@ -10,6 +10,8 @@
 #include "../utils/logging.h"
 #include "../utils/memory.h"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
 using namespace std;
@@ -17,23 +19,163 @@ using namespace std;
 namespace lm_cut_heuristic {
 LandmarkCutHeuristic::LandmarkCutHeuristic(const Options &opts)
     : Heuristic(opts),
-      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)) {
+      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)),
+      incremental(opts.get<bool>("incremental")),
+      parent_landmarks_computed(false),
+      parent_is_dead_end(false) {
     utils::g_log << "Initializing landmark cut heuristic..." << endl;
 }
 
 LandmarkCutHeuristic::~LandmarkCutHeuristic() {
 }
 
+void LandmarkCutHeuristic::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    if (incremental)
+        evals.insert(this);
+}
+
+void LandmarkCutHeuristic::notify_state_transition(
+    const State &parent, OperatorID op_id, const State &state) {
+    if (!parent_state || parent_state->get_id() != parent.get_id()) {
+        parent_state = utils::make_unique_ptr<State>(parent);
+        parent_landmarks_computed = false;
+        /*
+          Take over the landmarks recorded when the parent was evaluated
+          and release the memory of the recorded list.
+        */
+        vector<int> &recorded_landmarks = state_landmarks[parent];
+        parent_landmarks = move(recorded_landmarks);
+        vector<int>().swap(recorded_landmarks);
+        successor_operators.clear();
+    }
+    // Keep the first operator if several operators lead to the state.
+    successor_operators.emplace(state.get_id(), op_id.get_index());
+}
+
+static void add_landmark(
+    vector<int> &landmarks, const vector<int> &op_ids, int cost) {
+    ++landmarks[0];
+    landmarks.push_back(cost);
+    landmarks.push_back(op_ids.size());
+    landmarks.insert(landmarks.end(), op_ids.begin(), op_ids.end());
+}
+
+void LandmarkCutHeuristic::compute_parent_landmarks() {
+    parent_is_dead_end = false;
+    if (parent_landmarks.empty()) {
+        // The landmarks were not recorded, so we compute them again.
+        parent_landmarks.assign(1, 0);
+        parent_is_dead_end = landmark_generator->compute_landmarks(
+            convert_ancestor_state(*parent_state),
+            nullptr,
+            [this](const vector<int> &op_ids, int cut_cost) {
+                add_landmark(parent_landmarks, op_ids, cut_cost);
+            });
+    }
+
+    parent_remaining_costs.clear();
+    for (OperatorProxy op : task_proxy.get_operators())
+        parent_remaining_costs.push_back(op.get_cost());
+    int num_landmarks = parent_landmarks[0];
+    size_t pos = 1;
+    for (int i = 0; i < num_landmarks; ++i) {
+        int cost = parent_landmarks[pos];
+        int num_operators = parent_landmarks[pos + 1];
+        pos += 2;
+        for (int j = 0; j < num_operators; ++j)
+            parent_remaining_costs[parent_landmarks[pos + j]] -= cost;
+        pos += num_operators;
+    }
+    assert(pos == parent_landmarks.size());
+    parent_landmarks_computed = true;
+}
+
+int LandmarkCutHeuristic::compute_heuristic_from_parent(
+    const State &ancestor_state, const State &state, int op_id) {
+    if (!parent_landmarks_computed)
+        compute_parent_landmarks();
+    if (parent_is_dead_end) {
+        // Successors of relaxed dead ends are relaxed dead ends.
+        return DEAD_END;
+    }
+
+    /*
+      Landmarks that contain the operator leading to the state are
+      dropped, and their costs are given back to their operators. The
+      other landmarks are inherited by the state.
+    */
+    int total_cost = 0;
+    operator_costs = parent_remaining_costs;
+    vector<int> landmarks(1, 0);
+    int num_landmarks = parent_landmarks[0];
+    size_t pos = 1;
+    for (int i = 0; i < num_landmarks; ++i) {
+        int cost = parent_landmarks[pos];
+        int num_operators = parent_landmarks[pos + 1];
+        auto begin = parent_landmarks.begin() + pos + 2;
+        auto end = begin + num_operators;
+        if (find(begin, end, op_id) == end) {
+            total_cost += cost;
+            ++landmarks[0];
+            landmarks.insert(
+                landmarks.end(), parent_landmarks.begin() + pos, end);
+        } else {
+            for (auto it = begin; it != end; ++it)
+                operator_costs[*it] += cost;
+        }
+        pos += 2 + num_operators;
+    }
+
+    bool dead_end = landmark_generator->compute_landmarks(
+        state,
+        nullptr,
+        [&](const vector<int> &op_ids, int cut_cost) {
+            total_cost += cut_cost;
+            add_landmark(landmarks, op_ids, cut_cost);
+        },
+        &operator_costs);
+
+    if (dead_end)
+        return DEAD_END;
+    state_landmarks[ancestor_state] = move(landmarks);
+    return total_cost;
+}
+
 int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
+    if (!incremental) {
+        int total_cost = 0;
+        bool dead_end = landmark_generator->compute_landmarks(
+            state,
+            [&total_cost](int cut_cost) {total_cost += cut_cost;},
+            nullptr);
+
+        if (dead_end)
+            return DEAD_END;
+        return total_cost;
+    }
+
+    if (parent_state) {
+        auto it = successor_operators.find(ancestor_state.get_id());
+        if (it != successor_operators.end())
+            return compute_heuristic_from_parent(
+                ancestor_state, state, it->second);
+    }
+
     int total_cost = 0;
+    vector<int> landmarks(1, 0);
     bool dead_end = landmark_generator->compute_landmarks(
         state,
-        [&total_cost](int cut_cost) {total_cost += cut_cost;},
-        nullptr);
+        nullptr,
+        [&](const vector<int> &op_ids, int cut_cost) {
+            total_cost += cut_cost;
+            add_landmark(landmarks, op_ids, cut_cost);
+        });
 
     if (dead_end)
         return DEAD_END;
+    state_landmarks[ancestor_state] = move(landmarks);
     return total_cost;
 }
 
@@ -47,6 +189,14 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes");
     parser.document_property("preferred operators", "no");
 
+    parser.add_option<bool>(
+        "incremental",
+        "reuse the landmarks of the expanded state that do not contain the "
+        "operator leading to a successor for evaluating the successor "
+        "(only has an effect in search algorithms that report state "
+        "transitions to path-dependent evaluators, e.g., eager search). "
+        "The estimates can differ from those of plain LM-cut.",
+        "false");
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
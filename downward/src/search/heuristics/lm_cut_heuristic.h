@@ -2,8 +2,12 @@
 #define HEURISTICS_LM_CUT_HEURISTIC_H
 
 #include "../heuristic.h"
+#include "../per_state_information.h"
+
+#include "../utils/hash.h"
 
 #include <memory>
+#include <vector>
 
 namespace options {
 class Options;
@@ -12,13 +16,58 @@ class Options;
 namespace lm_cut_heuristic {
 class LandmarkCutLandmarks;
 
+/*
+  In incremental mode, successors of the expanded state inherit the
+  landmarks of their parent: a landmark of a state s that does not
+  contain operator o is also a landmark of s[o]. The inherited landmarks
+  keep their costs, and LM-cut is only run on the remaining operator
+  costs. This cost partitioning is admissible, but the estimates can
+  differ from plain LM-cut (in both directions).
+
+  The landmarks found when evaluating a state (inherited and new ones)
+  are stored until the state is expanded, and are then used for all of
+  its successors. If they are not available, e.g., when a state is
+  expanded a second time, they are recomputed with plain LM-cut.
+*/
 class LandmarkCutHeuristic : public Heuristic {
     std::unique_ptr<LandmarkCutLandmarks> landmark_generator;
+    const bool incremental;
+
+    std::vector<int> operator_costs;
+
+    /*
+      Incremental mode: the landmarks of evaluated states that have not
+      been expanded yet. A landmark list stores the number of landmarks,
+      followed by the cost, the number of operators and the operators of
+      each landmark. The list of a state without recorded landmarks is
+      empty.
+    */
+    PerStateInformation<std::vector<int>> state_landmarks;
+
+    // Incremental mode: the expanded state and its landmarks.
+    std::unique_ptr<State> parent_state;
+    bool parent_landmarks_computed;
+    bool parent_is_dead_end;
+    std::vector<int> parent_landmarks;
+    // Operator costs minus the costs of all landmarks of the parent.
+    std::vector<int> parent_remaining_costs;
+    // Successors of the expanded state with the operators leading to them.
+    utils::HashMap<StateID, int> successor_operators;
+
+    void compute_parent_landmarks();
+    int compute_heuristic_from_parent(
+        const State &ancestor_state, const State &state, int op_id);
 
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     explicit LandmarkCutHeuristic(const options::Options &opts);
     virtual ~LandmarkCutHeuristic() override;
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void notify_state_transition(
+        const State &parent_state, OperatorID op_id,
+        const State &state) override;
 };
 }
 
@@ -15,18 +15,29 @@ LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
     task_properties::verify_no_conditional_effects(task_proxy);
 
     // Build propositions.
-    num_propositions = 2; // artificial goal and artificial precondition
     VariablesProxy variables = task_proxy.get_variables();
-    propositions.resize(variables.size());
-    for (FactProxy fact : variables.get_facts()) {
-        int var_id = fact.get_variable().get_id();
-        propositions[var_id].push_back(RelaxedProposition());
-        ++num_propositions;
+    int num_facts = 0;
+    for (VariableProxy var : variables) {
+        proposition_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
     }
+    artificial_precondition = num_facts;
+    artificial_goal = num_facts + 1;
+    num_propositions = num_facts + 2;
+    propositions.resize(num_propositions);
 
     // Build relaxed operators for operators and axioms.
-    for (OperatorProxy op : task_proxy.get_operators())
-        build_relaxed_operator(op);
+    vector<int> precondition;
+    vector<int> effects;
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        precondition.clear();
+        effects.clear();
+        for (FactProxy pre : op.get_preconditions())
+            precondition.push_back(get_proposition(pre));
+        for (EffectProxy eff : op.get_effects())
+            effects.push_back(get_proposition(eff.get_fact()));
+        add_relaxed_operator(precondition, effects, op.get_id(), op.get_cost());
+    }
 
     // Simplify relaxed operators.
     // simplify();
@@ -35,74 +46,90 @@ LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
        unary operators hurts. */
 
     // Build artificial goal proposition and operator.
-    vector<RelaxedProposition *> goal_op_pre, goal_op_eff;
+    vector<int> goal_op_pre, goal_op_eff;
     for (FactProxy goal : task_proxy.get_goals()) {
         goal_op_pre.push_back(get_proposition(goal));
     }
-    goal_op_eff.push_back(&artificial_goal);
+    goal_op_eff.push_back(artificial_goal);
     /* Use the invalid operator ID -1 so accessing
        the artificial operator will generate an error. */
-    add_relaxed_operator(move(goal_op_pre), move(goal_op_eff), -1, 0);
+    add_relaxed_operator(goal_op_pre, goal_op_eff, -1, 0);
 
-    // Cross-reference relaxed operators.
-    for (RelaxedOperator &op : relaxed_operators) {
-        for (RelaxedProposition *pre : op.preconditions)
-            pre->precondition_of.push_back(&op);
-        for (RelaxedProposition *eff : op.effects)
-            eff->effect_of.push_back(&op);
-    }
+    cross_reference_operators();
 }
 
 LandmarkCutLandmarks::~LandmarkCutLandmarks() {
 }
 
-void LandmarkCutLandmarks::build_relaxed_operator(const OperatorProxy &op) {
-    vector<RelaxedProposition *> precondition;
-    vector<RelaxedProposition *> effects;
-    for (FactProxy pre : op.get_preconditions()) {
-        precondition.push_back(get_proposition(pre));
-    }
-    for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(get_proposition(eff.get_fact()));
-    }
-    add_relaxed_operator(
-        move(precondition), move(effects), op.get_id(), op.get_cost());
-}
-
 void LandmarkCutLandmarks::add_relaxed_operator(
-    vector<RelaxedProposition *> &&precondition,
-    vector<RelaxedProposition *> &&effects,
+    const vector<int> &precondition, const vector<int> &effects,
     int op_id, int base_cost) {
-    RelaxedOperator relaxed_op(
-        move(precondition), move(effects), op_id, base_cost);
-    if (relaxed_op.preconditions.empty())
-        relaxed_op.preconditions.push_back(&artificial_precondition);
+    RelaxedOperator relaxed_op(op_id, base_cost);
+    relaxed_op.preconditions_begin = operator_preconditions.size();
+    if (precondition.empty()) {
+        operator_preconditions.push_back(artificial_precondition);
+    } else {
+        operator_preconditions.insert(
+            operator_preconditions.end(), precondition.begin(), precondition.end());
+    }
+    relaxed_op.preconditions_end = operator_preconditions.size();
+    relaxed_op.effects_begin = operator_effects.size();
+    operator_effects.insert(
+        operator_effects.end(), effects.begin(), effects.end());
+    relaxed_op.effects_end = operator_effects.size();
     relaxed_operators.push_back(relaxed_op);
 }
 
-RelaxedProposition *LandmarkCutLandmarks::get_proposition(
-    const FactProxy &fact) {
-    int var_id = fact.get_variable().get_id();
-    int val = fact.get_value();
-    return &propositions[var_id][val];
+void LandmarkCutLandmarks::cross_reference_operators() {
+    /*
+      Sort the operators by proposition with a counting sort, so that
+      the operators of each proposition form a consecutive range.
+    */
+    vector<int> num_precondition_of(num_propositions, 0);
+    vector<int> num_effect_of(num_propositions, 0);
+    for (const RelaxedOperator &op : relaxed_operators) {
+        for (int i = op.preconditions_begin; i < op.preconditions_end; ++i)
+            ++num_precondition_of[operator_preconditions[i]];
+        for (int i = op.effects_begin; i < op.effects_end; ++i)
+            ++num_effect_of[operator_effects[i]];
+    }
+    int precondition_of_size = 0;
+    int effect_of_size = 0;
+    for (int prop_id = 0; prop_id < num_propositions; ++prop_id) {
+        RelaxedProposition &prop = propositions[prop_id];
+        prop.precondition_of_begin = precondition_of_size;
+        prop.precondition_of_end = precondition_of_size;
+        precondition_of_size += num_precondition_of[prop_id];
+        prop.effect_of_begin = effect_of_size;
+        prop.effect_of_end = effect_of_size;
+        effect_of_size += num_effect_of[prop_id];
+    }
+    precondition_of.resize(precondition_of_size);
+    effect_of.resize(effect_of_size);
+    for (size_t op_id = 0; op_id < relaxed_operators.size(); ++op_id) {
+        const RelaxedOperator &op = relaxed_operators[op_id];
+        for (int i = op.preconditions_begin; i < op.preconditions_end; ++i) {
+            RelaxedProposition &pre = propositions[operator_preconditions[i]];
+            precondition_of[pre.precondition_of_end++] = op_id;
+        }
+        for (int i = op.effects_begin; i < op.effects_end; ++i) {
+            RelaxedProposition &eff = propositions[operator_effects[i]];
+            effect_of[eff.effect_of_end++] = op_id;
+        }
+    }
 }
 
 // heuristic computation
 void LandmarkCutLandmarks::setup_exploration_queue() {
     priority_queue.clear();
 
-    for (auto &var_props : propositions) {
-        for (RelaxedProposition &prop : var_props) {
-            prop.status = UNREACHED;
-        }
+    for (RelaxedProposition &prop : propositions) {
+        prop.status = UNREACHED;
     }
 
-    artificial_goal.status = UNREACHED;
-    artificial_precondition.status = UNREACHED;
-
     for (RelaxedOperator &op : relaxed_operators) {
-        op.unsatisfied_preconditions = op.preconditions.size();
-        op.h_max_supporter = 0;
+        op.unsatisfied_preconditions = op.get_num_preconditions();
+        op.h_max_supporter = NO_SUPPORTER;
         op.h_max_supporter_cost = numeric_limits<int>::max();
     }
 }
@@ -111,7 +138,7 @@ void LandmarkCutLandmarks::setup_exploration_queue_state(const State &state) {
     for (FactProxy init_fact : state) {
         enqueue_if_necessary(get_proposition(init_fact), 0);
     }
-    enqueue_if_necessary(&artificial_precondition, 0);
+    enqueue_if_necessary(artificial_precondition, 0);
 }
 
 void LandmarkCutLandmarks::first_exploration(const State &state) {
@@ -119,32 +146,31 @@ void LandmarkCutLandmarks::first_exploration(const State &state) {
     setup_exploration_queue();
     setup_exploration_queue_state(state);
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, int> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        int prop_id = top_pair.second;
+        const RelaxedProposition &prop = propositions[prop_id];
+        int prop_cost = prop.h_max_cost;
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            --relaxed_op->unsatisfied_preconditions;
-            assert(relaxed_op->unsatisfied_preconditions >= 0);
-            if (relaxed_op->unsatisfied_preconditions == 0) {
-                relaxed_op->h_max_supporter = prop;
-                relaxed_op->h_max_supporter_cost = prop_cost;
-                int target_cost = prop_cost + relaxed_op->cost;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
-                    enqueue_if_necessary(effect, target_cost);
+        for (int i = prop.precondition_of_begin; i < prop.precondition_of_end; ++i) {
+            RelaxedOperator &relaxed_op = relaxed_operators[precondition_of[i]];
+            --relaxed_op.unsatisfied_preconditions;
+            assert(relaxed_op.unsatisfied_preconditions >= 0);
+            if (relaxed_op.unsatisfied_preconditions == 0) {
+                relaxed_op.h_max_supporter = prop_id;
+                relaxed_op.h_max_supporter_cost = prop_cost;
+                int target_cost = prop_cost + relaxed_op.cost;
+                for (int j = relaxed_op.effects_begin; j < relaxed_op.effects_end; ++j) {
+                    enqueue_if_necessary(operator_effects[j], target_cost);
                 }
             }
         }
     }
 }
 
-void LandmarkCutLandmarks::first_exploration_incremental(
-    vector<RelaxedOperator *> &cut) {
+void LandmarkCutLandmarks::first_exploration_incremental(vector<int> &cut) {
     assert(priority_queue.empty());
     /* We pretend that this queue has had as many pushes already as we
        have propositions to avoid switching from bucket-based to
@@ -152,33 +178,34 @@ void LandmarkCutLandmarks::first_exploration_incremental(
        to heap-based in problems where action costs are at most 1.
     */
     priority_queue.add_virtual_pushes(num_propositions);
-    for (RelaxedOperator *relaxed_op : cut) {
-        int cost = relaxed_op->h_max_supporter_cost + relaxed_op->cost;
-        for (RelaxedProposition *effect : relaxed_op->effects)
-            enqueue_if_necessary(effect, cost);
+    for (int op_id : cut) {
+        const RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+        int cost = relaxed_op.h_max_supporter_cost + relaxed_op.cost;
+        for (int i = relaxed_op.effects_begin; i < relaxed_op.effects_end; ++i)
+            enqueue_if_necessary(operator_effects[i], cost);
     }
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, int> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        int prop_id = top_pair.second;
+        const RelaxedProposition &prop = propositions[prop_id];
+        int prop_cost = prop.h_max_cost;
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
-                int old_supp_cost = relaxed_op->h_max_supporter_cost;
+        for (int i = prop.precondition_of_begin; i < prop.precondition_of_end; ++i) {
+            RelaxedOperator &relaxed_op = relaxed_operators[precondition_of[i]];
+            if (relaxed_op.h_max_supporter == prop_id) {
+                int old_supp_cost = relaxed_op.h_max_supporter_cost;
                 if (old_supp_cost > prop_cost) {
-                    relaxed_op->update_h_max_supporter();
-                    int new_supp_cost = relaxed_op->h_max_supporter_cost;
+                    update_h_max_supporter(relaxed_op);
+                    int new_supp_cost = relaxed_op.h_max_supporter_cost;
                     if (new_supp_cost != old_supp_cost) {
                         // This operator has become cheaper.
                         assert(new_supp_cost < old_supp_cost);
-                        int target_cost = new_supp_cost + relaxed_op->cost;
-                        for (RelaxedProposition *effect : relaxed_op->effects)
-                            enqueue_if_necessary(effect, target_cost);
+                        int target_cost = new_supp_cost + relaxed_op.cost;
+                        for (int j = relaxed_op.effects_begin; j < relaxed_op.effects_end; ++j)
+                            enqueue_if_necessary(operator_effects[j], target_cost);
                     }
                 }
             }
@@ -187,41 +214,43 @@ void LandmarkCutLandmarks::first_exploration_incremental(
 }
 
 void LandmarkCutLandmarks::second_exploration(
-    const State &state, vector<RelaxedProposition *> &second_exploration_queue,
-    vector<RelaxedOperator *> &cut) {
+    const State &state, vector<int> &second_exploration_queue,
+    vector<int> &cut) {
     assert(second_exploration_queue.empty());
     assert(cut.empty());
 
-    artificial_precondition.status = BEFORE_GOAL_ZONE;
-    second_exploration_queue.push_back(&artificial_precondition);
+    propositions[artificial_precondition].status = BEFORE_GOAL_ZONE;
+    second_exploration_queue.push_back(artificial_precondition);
 
     for (FactProxy init_fact : state) {
-        RelaxedProposition *init_prop = get_proposition(init_fact);
-        init_prop->status = BEFORE_GOAL_ZONE;
+        int init_prop = get_proposition(init_fact);
+        propositions[init_prop].status = BEFORE_GOAL_ZONE;
         second_exploration_queue.push_back(init_prop);
     }
 
     while (!second_exploration_queue.empty()) {
-        RelaxedProposition *prop = second_exploration_queue.back();
+        int prop_id = second_exploration_queue.back();
         second_exploration_queue.pop_back();
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
+        const RelaxedProposition &prop = propositions[prop_id];
+        for (int i = prop.precondition_of_begin; i < prop.precondition_of_end; ++i) {
+            int op_id = precondition_of[i];
+            const RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            if (relaxed_op.h_max_supporter == prop_id) {
                 bool reached_goal_zone = false;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
-                    if (effect->status == GOAL_ZONE) {
-                        assert(relaxed_op->cost > 0);
+                for (int j = relaxed_op.effects_begin; j < relaxed_op.effects_end; ++j) {
+                    if (propositions[operator_effects[j]].status == GOAL_ZONE) {
+                        assert(relaxed_op.cost > 0);
                         reached_goal_zone = true;
-                        cut.push_back(relaxed_op);
+                        cut.push_back(op_id);
                         break;
                     }
                 }
                 if (!reached_goal_zone) {
-                    for (RelaxedProposition *effect : relaxed_op->effects) {
-                        if (effect->status != BEFORE_GOAL_ZONE) {
-                            assert(effect->status == REACHED);
-                            effect->status = BEFORE_GOAL_ZONE;
+                    for (int j = relaxed_op.effects_begin; j < relaxed_op.effects_end; ++j) {
+                        int effect = operator_effects[j];
+                        if (propositions[effect].status != BEFORE_GOAL_ZONE) {
+                            assert(propositions[effect].status == REACHED);
+                            propositions[effect].status = BEFORE_GOAL_ZONE;
                             second_exploration_queue.push_back(effect);
                         }
                     }
@@ -231,16 +260,19 @@ void LandmarkCutLandmarks::second_exploration(
     }
 }
 
-void LandmarkCutLandmarks::mark_goal_plateau(RelaxedProposition *subgoal) {
-    // NOTE: subgoal can be null if we got here via recursion through
-    // a zero-cost action that is relaxed unreachable. (This can only
-    // happen in domains which have zero-cost actions to start with.)
+void LandmarkCutLandmarks::mark_goal_plateau(int subgoal) {
+    // NOTE: subgoal can be NO_SUPPORTER if we got here via recursion
+    // through a zero-cost action that is relaxed unreachable. (This can
+    // only happen in domains which have zero-cost actions to start with.)
     // For example, this happens in pegsol-strips #01.
-    if (subgoal && subgoal->status != GOAL_ZONE) {
-        subgoal->status = GOAL_ZONE;
-        for (RelaxedOperator *achiever : subgoal->effect_of)
-            if (achiever->cost == 0)
-                mark_goal_plateau(achiever->h_max_supporter);
+    if (subgoal != NO_SUPPORTER && propositions[subgoal].status != GOAL_ZONE) {
+        RelaxedProposition &prop = propositions[subgoal];
+        prop.status = GOAL_ZONE;
+        for (int i = prop.effect_of_begin; i < prop.effect_of_end; ++i) {
+            const RelaxedOperator &achiever = relaxed_operators[effect_of[i]];
+            if (achiever.cost == 0)
+                mark_goal_plateau(achiever.h_max_supporter);
+        }
     }
 }
 
@@ -252,21 +284,22 @@ void LandmarkCutLandmarks::validate_h_max() const {
     for (const RelaxedOperator &op : relaxed_operators) {
         if (op.unsatisfied_preconditions) {
             bool reachable = true;
-            for (RelaxedProposition *pre : op.preconditions) {
-                if (pre->status == UNREACHED) {
+            for (int i = op.preconditions_begin; i < op.preconditions_end; ++i) {
+                if (propositions[operator_preconditions[i]].status == UNREACHED) {
                     reachable = false;
                     break;
                 }
             }
             assert(!reachable);
-            assert(!op.h_max_supporter);
+            assert(op.h_max_supporter == NO_SUPPORTER);
         } else {
-            assert(op.h_max_supporter);
+            assert(op.h_max_supporter != NO_SUPPORTER);
             int h_max_cost = op.h_max_supporter_cost;
-            assert(h_max_cost == op.h_max_supporter->h_max_cost);
-            for (RelaxedProposition *pre : op.preconditions) {
-                assert(pre->status != UNREACHED);
-                assert(pre->h_max_cost <= h_max_cost);
+            assert(h_max_cost == propositions[op.h_max_supporter].h_max_cost);
+            for (int i = op.preconditions_begin; i < op.preconditions_end; ++i) {
+                const RelaxedProposition &pre = propositions[operator_preconditions[i]];
+                assert(pre.status != UNREACHED);
+                assert(pre.h_max_cost <= h_max_cost);
             }
         }
     }
@@ -275,42 +308,46 @@ void LandmarkCutLandmarks::validate_h_max() const {
 
 bool LandmarkCutLandmarks::compute_landmarks(
     const State &state, CostCallback cost_callback,
-    LandmarkCallback landmark_callback) {
+    LandmarkCallback landmark_callback, const vector<int> *operator_costs) {
     for (RelaxedOperator &op : relaxed_operators) {
-        op.cost = op.base_cost;
+        if (operator_costs && op.original_op_id != -1)
+            op.cost = (*operator_costs)[op.original_op_id];
+        else
+            op.cost = op.base_cost;
+        assert(op.cost >= 0);
     }
     // The following three variables could be declared inside the loop
     // ("second_exploration_queue" even inside second_exploration),
     // but having them here saves reallocations and hence provides a
     // measurable speed boost.
-    vector<RelaxedOperator *> cut;
+    vector<int> cut;
     Landmark landmark;
-    vector<RelaxedProposition *> second_exploration_queue;
+    vector<int> second_exploration_queue;
     first_exploration(state);
     // validate_h_max();  // too expensive to use even in regular debug mode
-    if (artificial_goal.status == UNREACHED)
+    if (propositions[artificial_goal].status == UNREACHED)
         return true;
 
     int num_iterations = 0;
-    while (artificial_goal.h_max_cost != 0) {
+    while (propositions[artificial_goal].h_max_cost != 0) {
         ++num_iterations;
-        mark_goal_plateau(&artificial_goal);
+        mark_goal_plateau(artificial_goal);
         assert(cut.empty());
         second_exploration(state, second_exploration_queue, cut);
         assert(!cut.empty());
         int cut_cost = numeric_limits<int>::max();
-        for (RelaxedOperator *op : cut)
-            cut_cost = min(cut_cost, op->cost);
-        for (RelaxedOperator *op : cut)
-            op->cost -= cut_cost;
+        for (int op_id : cut)
+            cut_cost = min(cut_cost, relaxed_operators[op_id].cost);
+        for (int op_id : cut)
+            relaxed_operators[op_id].cost -= cut_cost;
 
         if (cost_callback) {
             cost_callback(cut_cost);
         }
         if (landmark_callback) {
             landmark.clear();
-            for (RelaxedOperator *op : cut) {
-                landmark.push_back(op->original_op_id);
+            for (int op_id : cut) {
+                landmark.push_back(relaxed_operators[op_id].original_op_id);
             }
             landmark_callback(landmark, cut_cost);
         }
@@ -325,14 +362,10 @@ bool LandmarkCutLandmarks::compute_landmarks(
           or something based on total_cost, so that we don't need a per-round
           reinitialization.
         */
-        for (auto &var_props : propositions) {
-            for (RelaxedProposition &prop : var_props) {
-                if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
-                    prop.status = REACHED;
-            }
+        for (RelaxedProposition &prop : propositions) {
+            if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
+                prop.status = REACHED;
         }
-        artificial_goal.status = REACHED;
-        artificial_precondition.status = REACHED;
     }
     return false;
 }
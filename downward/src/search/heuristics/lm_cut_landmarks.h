@@ -12,7 +12,6 @@
 
 namespace lm_cut_heuristic {
 // TODO: Fix duplication with the other relaxation heuristics.
-struct RelaxedProposition;
 
 enum PropositionStatus {
     UNREACHED = 0,
@@ -21,64 +20,101 @@ enum PropositionStatus {
     BEFORE_GOAL_ZONE = 3
 };
 
+/*
+  Relaxed operators and propositions are stored in flat vectors and
+  refer to each other by index. Their preconditions, effects,
+  precondition_of and effect_of lists are consecutive ranges
+  [begin, end) of shared index vectors in LandmarkCutLandmarks.
+*/
+const int NO_SUPPORTER = -1;
+
 struct RelaxedOperator {
     int original_op_id;
-    std::vector<RelaxedProposition *> preconditions;
-    std::vector<RelaxedProposition *> effects;
+    int preconditions_begin;
+    int preconditions_end;
+    int effects_begin;
+    int effects_end;
     int base_cost; // 0 for axioms, 1 for regular operators
 
     int cost;
     int unsatisfied_preconditions;
     int h_max_supporter_cost; // h_max_cost of h_max_supporter
-    RelaxedProposition *h_max_supporter;
-    RelaxedOperator(std::vector<RelaxedProposition *> &&pre,
-                    std::vector<RelaxedProposition *> &&eff,
-                    int op_id, int base)
-        : original_op_id(op_id), preconditions(pre), effects(eff), base_cost(base) {
+    int h_max_supporter;
+
+    RelaxedOperator(int op_id, int base)
+        : original_op_id(op_id),
+          preconditions_begin(0), preconditions_end(0),
+          effects_begin(0), effects_end(0),
+          base_cost(base),
+          cost(base),
+          unsatisfied_preconditions(0),
+          h_max_supporter_cost(0),
+          h_max_supporter(NO_SUPPORTER) {
     }
 
-    inline void update_h_max_supporter();
+    int get_num_preconditions() const {
+        return preconditions_end - preconditions_begin;
+    }
 };
 
 struct RelaxedProposition {
-    std::vector<RelaxedOperator *> precondition_of;
-    std::vector<RelaxedOperator *> effect_of;
+    int precondition_of_begin;
+    int precondition_of_end;
+    int effect_of_begin;
+    int effect_of_end;
 
     PropositionStatus status;
     int h_max_cost;
+
+    RelaxedProposition()
+        : precondition_of_begin(0), precondition_of_end(0),
+          effect_of_begin(0), effect_of_end(0),
+          status(UNREACHED), h_max_cost(0) {
+    }
 };
 
 class LandmarkCutLandmarks {
     std::vector<RelaxedOperator> relaxed_operators;
-    std::vector<std::vector<RelaxedProposition>> propositions;
-    RelaxedProposition artificial_precondition;
-    RelaxedProposition artificial_goal;
+    std::vector<RelaxedProposition> propositions;
+    // proposition_offsets[var]: index of the proposition for (var, 0)
+    std::vector<int> proposition_offsets;
+    std::vector<int> operator_preconditions;
+    std::vector<int> operator_effects;
+    std::vector<int> precondition_of;
+    std::vector<int> effect_of;
+    int artificial_precondition;
+    int artificial_goal;
     int num_propositions;
-    priority_queues::AdaptiveQueue<RelaxedProposition *> priority_queue;
+    priority_queues::AdaptiveQueue<int> priority_queue;
 
-    void build_relaxed_operator(const OperatorProxy &op);
-    void add_relaxed_operator(std::vector<RelaxedProposition *> &&precondition,
-                              std::vector<RelaxedProposition *> &&effects,
+    void add_relaxed_operator(const std::vector<int> &preconditions,
+                              const std::vector<int> &effects,
                               int op_id, int base_cost);
-    RelaxedProposition *get_proposition(const FactProxy &fact);
+    void cross_reference_operators();
+    int get_proposition(const FactProxy &fact) const {
+        return proposition_offsets[fact.get_variable().get_id()] +
+               fact.get_value();
+    }
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void first_exploration(const State &state);
-    void first_exploration_incremental(std::vector<RelaxedOperator *> &cut);
+    void first_exploration_incremental(std::vector<int> &cut);
     void second_exploration(const State &state,
-                            std::vector<RelaxedProposition *> &second_exploration_queue,
-                            std::vector<RelaxedOperator *> &cut);
+                            std::vector<int> &second_exploration_queue,
+                            std::vector<int> &cut);
 
-    void enqueue_if_necessary(RelaxedProposition *prop, int cost) {
+    void enqueue_if_necessary(int prop_id, int cost) {
         assert(cost >= 0);
-        if (prop->status == UNREACHED || prop->h_max_cost > cost) {
-            prop->status = REACHED;
-            prop->h_max_cost = cost;
-            priority_queue.push(cost, prop);
+        RelaxedProposition &prop = propositions[prop_id];
+        if (prop.status == UNREACHED || prop.h_max_cost > cost) {
+            prop.status = REACHED;
+            prop.h_max_cost = cost;
+            priority_queue.push(cost, prop_id);
         }
     }
 
-    void mark_goal_plateau(RelaxedProposition *subgoal);
+    inline void update_h_max_supporter(RelaxedOperator &op);
+    void mark_goal_plateau(int subgoal);
     void validate_h_max() const;
 public:
     using Landmark = std::vector<int>;
@@ -99,18 +135,31 @@ public:
       making a copy of the landmark, so cost_callback should be used if only the
       cost of the landmark is needed.
 
+      If operator_costs is not nullptr, it replaces the operator costs of
+      the task, e.g., to compute landmarks for the costs that remain after
+      subtracting the costs of previously known landmarks.
+
       Returns true iff state is detected as a dead end.
     */
     bool compute_landmarks(const State &state, CostCallback cost_callback,
-                           LandmarkCallback landmark_callback);
+                           LandmarkCallback landmark_callback,
+                           const std::vector<int> *operator_costs = nullptr);
 };
 
-inline void RelaxedOperator::update_h_max_supporter() {
-    assert(!unsatisfied_preconditions);
-    for (size_t i = 0; i < preconditions.size(); ++i)
-        if (preconditions[i]->h_max_cost > h_max_supporter->h_max_cost)
-            h_max_supporter = preconditions[i];
-    h_max_supporter_cost = h_max_supporter->h_max_cost;
+inline void LandmarkCutLandmarks::update_h_max_supporter(RelaxedOperator &op) {
+    assert(!op.unsatisfied_preconditions);
+    int supporter = op.h_max_supporter;
+    int supporter_cost = propositions[supporter].h_max_cost;
+    for (int i = op.preconditions_begin; i < op.preconditions_end; ++i) {
+        int pre = operator_preconditions[i];
+        int pre_cost = propositions[pre].h_max_cost;
+        if (pre_cost > supporter_cost) {
+            supporter = pre;
+            supporter_cost = pre_cost;
+        }
+    }
+    op.h_max_supporter = supporter;
+    op.h_max_supporter_cost = supporter_cost;
 }
 }
 
@@ -36,13 +36,13 @@ void HSPMaxHeuristic::setup_exploration_queue() {
     for (Proposition &prop : propositions)
         prop.cost = -1;
 
-    // Deal with operators and axioms without preconditions.
-    for (UnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.num_preconditions;
-        op.cost = op.base_cost; // will be increased by precondition costs
+    // Operator costs will be increased by precondition costs.
+    reset_explored_operators();
 
-        if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost);
+    // Deal with operators and axioms without preconditions.
+    for (OpID op_id : operators_without_preconditions) {
+        const UnaryOperator *op = get_operator(op_id);
+        enqueue_if_necessary(op->effect, op->base_cost);
     }
 }
 
@@ -69,13 +69,13 @@ void HSPMaxHeuristic::relaxed_exploration() {
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
-            UnaryOperator *unary_op = get_operator(op_id);
-            unary_op->cost = max(unary_op->cost,
-                                 unary_op->base_cost + prop_cost);
-            --unary_op->unsatisfied_preconditions;
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect, unary_op->cost);
+            ExploredOperator &explored_op = explored_operators[op_id];
+            explored_op.cost = max(explored_op.cost,
+                                   get_operator(op_id)->base_cost + prop_cost);
+            --explored_op.unsatisfied_preconditions;
+            assert(explored_op.unsatisfied_preconditions >= 0);
+            if (explored_op.unsatisfied_preconditions == 0)
+                enqueue_if_necessary(explored_op.effect, explored_op.cost);
         }
     }
 }
@@ -88,6 +88,17 @@ RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
             precondition_of_pool.append(precondition_of_vec);
         propositions[prop_id].num_precondition_occurences = precondition_of_vec.size();
     }
+
+    // Set up the exploration state of the unary operators.
+    initial_explored_operators.reserve(num_unary_ops);
+    for (OpID op_id = 0; op_id < num_unary_ops; ++op_id) {
+        const UnaryOperator &op = unary_operators[op_id];
+        initial_explored_operators.push_back(
+            {op.base_cost, op.num_preconditions, op.effect});
+        if (op.num_preconditions == 0)
+            operators_without_preconditions.push_back(op_id);
+    }
+    reset_explored_operators();
 }
 
 bool RelaxationHeuristic::dead_ends_are_reliable() const {
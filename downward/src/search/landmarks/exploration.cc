@@ -10,10 +10,18 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include <mutex>
 
 using namespace std;
 
 namespace landmarks {
+/*
+  The landmark factories use one exploration per thread. This mutex
+  serializes the overflow warnings, which may be written while several
+  explorations run concurrently.
+*/
+static mutex overflow_warning_mutex;
+
 /* Integration Note: this class is the same as (rich man's) FF heuristic
    (taken from hector branch) except for the following:
    - Added-on functionality for excluding certain operators from the relaxed
@@ -87,6 +95,7 @@ void Exploration::write_overflow_warning() {
     if (!did_write_overflow_warning) {
         // TODO: Should have a planner-wide warning mechanism to handle
         // things like this.
+        lock_guard<mutex> lock(overflow_warning_mutex);
         utils::g_log << "WARNING: overflow on landmark exploration h^add! Costs clamped to "
                      << MAX_COST_VALUE << endl;
         did_write_overflow_warning = true;
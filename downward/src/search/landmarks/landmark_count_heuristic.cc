@@ -55,7 +55,8 @@ LandmarkCountHeuristic::LandmarkCountHeuristic(const options::Options &opts)
     shared_ptr<LandmarkFactory> lm_graph_factory = opts.get<shared_ptr<LandmarkFactory>>("lm_factory");
     lgraph = lm_graph_factory->compute_lm_graph(task);
     bool reasonable_orders = lm_graph_factory->use_reasonable_orders();
-    lm_status_manager = utils::make_unique_ptr<LandmarkStatusManager>(*lgraph);
+    lm_status_manager = utils::make_unique_ptr<LandmarkStatusManager>(
+        *lgraph, task_proxy, opts.get<bool>("incremental"));
 
     if (admissible) {
         if (reasonable_orders) {
@@ -86,9 +87,25 @@ LandmarkCountHeuristic::LandmarkCountHeuristic(const options::Options &opts)
         /* Ideally, we should reuse the successor generator of the main task in cases
            where it's compatible. See issue564. */
         successor_generator = utils::make_unique_ptr<successor_generator::SuccessorGenerator>(task_proxy);
+        compute_landmark_effects();
     }
 }
 
+void LandmarkCountHeuristic::compute_landmark_effects() {
+    OperatorsProxy operators = task_proxy.get_operators();
+    landmark_effects.resize(operators.size());
+    for (OperatorProxy op : operators) {
+        EffectsProxy effects = op.get_effects();
+        for (size_t eff_id = 0; eff_id < effects.size(); ++eff_id) {
+            LandmarkNode *lm = lgraph->get_landmark(
+                effects[eff_id].get_fact().get_pair());
+            if (lm)
+                landmark_effects[op.get_id()].emplace_back(eff_id, lm);
+        }
+    }
+    interesting_status.resize(lgraph->get_num_landmarks(), NOT_COMPUTED);
+}
+
 int LandmarkCountHeuristic::get_heuristic_value(const State &ancestor_state) {
     double epsilon = 0.01;
 
@@ -133,8 +150,7 @@ int LandmarkCountHeuristic::compute_heuristic(const State &ancestor_state) {
     int h = get_heuristic_value(ancestor_state);
 
     if (use_preferred_operators) {
-        BitsetView landmark_info = lm_status_manager->get_reached_landmarks(ancestor_state);
-        LandmarkSet reached_lms = convert_to_landmark_set(landmark_info);
+        BitsetView reached_lms = lm_status_manager->get_reached_landmarks(ancestor_state);
         generate_helpful_actions(state, reached_lms);
     }
 
@@ -142,9 +158,9 @@ int LandmarkCountHeuristic::compute_heuristic(const State &ancestor_state) {
 }
 
 bool LandmarkCountHeuristic::check_node_orders_disobeyed(const LandmarkNode &node,
-                                                         const LandmarkSet &reached) const {
+                                                         const BitsetView &reached) const {
     for (const auto &parent : node.parents) {
-        if (reached.count(parent.first) == 0) {
+        if (!reached.test(parent.first->get_id())) {
             return true;
         }
     }
@@ -152,7 +168,7 @@ bool LandmarkCountHeuristic::check_node_orders_disobeyed(const LandmarkNode &nod
 }
 
 bool LandmarkCountHeuristic::generate_helpful_actions(const State &state,
-                                                      const LandmarkSet &reached) {
+                                                      const BitsetView &reached) {
     /* Find actions that achieve new landmark leaves. If no such action exist,
      return false. If a simple landmark can be achieved, return only operators
      that achieve simple landmarks, else return operators that achieve
@@ -163,15 +179,22 @@ bool LandmarkCountHeuristic::generate_helpful_actions(const State &state,
     vector<OperatorID> ha_simple;
     vector<OperatorID> ha_disj;
 
+    int num_reached = 0;
+    for (int lm_id = 0; lm_id < reached.size(); ++lm_id) {
+        if (reached.test(lm_id))
+            ++num_reached;
+    }
+
     for (OperatorID op_id : applicable_operators) {
-        OperatorProxy op = task_proxy.get_operators()[op_id];
-        EffectsProxy effects = op.get_effects();
-        for (EffectProxy effect : effects) {
-            if (!does_fire(effect, state))
-                continue;
-            FactProxy fact_proxy = effect.get_fact();
-            LandmarkNode *lm_p = lgraph->get_landmark(fact_proxy.get_pair());
-            if (lm_p != 0 && landmark_is_interesting(state, reached, *lm_p)) {
+        const vector<pair<int, LandmarkNode *>> &op_landmark_effects =
+            landmark_effects[op_id.get_index()];
+        if (op_landmark_effects.empty())
+            continue;
+        EffectsProxy effects = task_proxy.get_operators()[op_id].get_effects();
+        for (const pair<int, LandmarkNode *> &landmark_effect : op_landmark_effects) {
+            const LandmarkNode *lm_p = landmark_effect.second;
+            if (landmark_is_interesting(state, reached, num_reached, *lm_p) &&
+                does_fire(effects[landmark_effect.first], state)) {
                 if (lm_p->disjunctive) {
                     ha_disj.push_back(op_id);
                 } else {
@@ -180,6 +203,10 @@ bool LandmarkCountHeuristic::generate_helpful_actions(const State &state,
             }
         }
     }
+    for (int lm_id : landmarks_with_status)
+        interesting_status[lm_id] = NOT_COMPUTED;
+    landmarks_with_status.clear();
+
     if (ha_disj.empty() && ha_simple.empty())
         return false;
 
@@ -197,19 +224,25 @@ bool LandmarkCountHeuristic::generate_helpful_actions(const State &state,
 }
 
 bool LandmarkCountHeuristic::landmark_is_interesting(
-    const State &state, const LandmarkSet &reached, LandmarkNode &lm) const {
+    const State &state, const BitsetView &reached, int num_reached,
+    const LandmarkNode &lm) {
     /* A landmark is interesting if it hasn't been reached before and
      its parents have all been reached, or if all landmarks have been
      reached before, the LM is a goal, and it's not true at moment */
 
-    int num_reached = reached.size();
-    if (num_reached != lgraph->get_num_landmarks()) {
-        if (reached.find(&lm) != reached.end())
-            return false;
-        else
-            return !check_node_orders_disobeyed(lm, reached);
+    InterestingStatus &status = interesting_status[lm.get_id()];
+    if (status == NOT_COMPUTED) {
+        bool interesting;
+        if (num_reached != lgraph->get_num_landmarks()) {
+            interesting = !reached.test(lm.get_id()) &&
+                !check_node_orders_disobeyed(lm, reached);
+        } else {
+            interesting = lm.is_true_in_goal && !lm.is_true_in_state(state);
+        }
+        status = interesting ? INTERESTING : NOT_INTERESTING;
+        landmarks_with_status.push_back(lm.get_id());
     }
-    return lm.is_true_in_goal && !lm.is_true_in_state(state);
+    return status == INTERESTING;
 }
 
 void LandmarkCountHeuristic::notify_initial_state(const State &initial_state) {
@@ -230,19 +263,6 @@ bool LandmarkCountHeuristic::dead_ends_are_reliable() const {
     return dead_ends_reliable;
 }
 
-// This function exists purely so we don't have to change all the
-// functions in this class that use LandmarkSets for the reached LMs
-// (HACK).
-LandmarkSet LandmarkCountHeuristic::convert_to_landmark_set(
-    const BitsetView &landmark_bitset) {
-    LandmarkSet landmark_set;
-    for (int i = 0; i < landmark_bitset.size(); ++i)
-        if (landmark_bitset.test(i))
-            landmark_set.insert(lgraph->get_landmark(i));
-    return landmark_set;
-}
-
-
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "Landmark-count heuristic",
@@ -353,6 +373,16 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
                             "(see OptionCaveats#Using_preferred_operators_"
                             "with_the_lmcount_heuristic)", "false");
     parser.add_option<bool>("alm", "use action landmarks", "true");
+    parser.add_option<bool>(
+        "incremental",
+        "after a transition, only reconsider the landmarks that can have "
+        "been reached by it (those containing an effect of the operator "
+        "and the children of newly reached landmarks) instead of all "
+        "landmarks. Unlike the non-incremental update, this does not "
+        "depend on the order of the landmarks, so a landmark that becomes "
+        "a leaf in the same step in which it is true is always reached. "
+        "Hence, the heuristic values can differ slightly.",
+        "false");
     lp::add_lp_solver_option_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
@@ -26,19 +26,34 @@ class LandmarkCountHeuristic : public Heuristic {
     std::unique_ptr<LandmarkCostAssignment> lm_cost_assignment;
     std::unique_ptr<successor_generator::SuccessorGenerator> successor_generator;
 
+    /*
+      For preferred operators: landmark_effects[op_id] lists the indices
+      of the effects of the operator that achieve a landmark, together
+      with the landmark. During the computation of preferred operators,
+      interesting_status caches whether a landmark is interesting
+      (NOT_COMPUTED, INTERESTING or NOT_INTERESTING) for the evaluated
+      state.
+    */
+    enum InterestingStatus {
+        NOT_COMPUTED,
+        INTERESTING,
+        NOT_INTERESTING
+    };
+    std::vector<std::vector<std::pair<int, LandmarkNode *>>> landmark_effects;
+    std::vector<InterestingStatus> interesting_status;
+    std::vector<int> landmarks_with_status;
+
     int get_heuristic_value(const State &ancestor_state);
 
     bool check_node_orders_disobeyed(
-        const LandmarkNode &node, const LandmarkSet &reached) const;
-
-    void add_node_children(LandmarkNode &node, const LandmarkSet &reached) const;
+        const LandmarkNode &node, const BitsetView &reached) const;
 
+    void compute_landmark_effects();
     bool landmark_is_interesting(
-        const State &state, const LandmarkSet &reached, LandmarkNode &lm) const;
+        const State &state, const BitsetView &reached, int num_reached,
+        const LandmarkNode &lm);
     bool generate_helpful_actions(
-        const State &state, const LandmarkSet &reached);
-
-    LandmarkSet convert_to_landmark_set(const BitsetView &landmark_bitset);
+        const State &state, const BitsetView &reached);
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
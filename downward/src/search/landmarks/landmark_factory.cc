@@ -1,5 +1,6 @@
 #include "landmark_factory.h"
 
+#include "exploration.h"
 #include "landmark_graph.h"
 
 #include "util.h"
@@ -10,6 +11,7 @@
 
 #include "../utils/logging.h"
 #include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/timer.h"
 
 #include <fstream>
@@ -24,6 +26,7 @@ LandmarkFactory::LandmarkFactory(const options::Options &opts)
       disjunctive_landmarks(opts.get<bool>("disjunctive_landmarks")),
       conjunctive_landmarks(opts.get<bool>("conjunctive_landmarks")),
       no_orders(opts.get<bool>("no_orders")),
+      num_threads(opts.get<int>("threads", 1)),
       lm_graph_task(nullptr) {
 }
 /*
@@ -77,9 +80,31 @@ shared_ptr<LandmarkGraph> LandmarkFactory::compute_lm_graph(
                      << lm_graph->get_num_conjunctive_landmarks() << " are conjunctive." << endl;
         utils::g_log << lm_graph->get_num_edges() << " edges" << endl;
     }
+    for (const PhaseTime &phase_time : phase_times) {
+        utils::g_log << "Landmark " << phase_time.phase << " time: "
+                     << utils::Duration(phase_time.wall_time) << " (CPU time: "
+                     << utils::Duration(phase_time.cpu_time) << ")" << endl;
+    }
     return lm_graph;
 }
 
+void LandmarkFactory::add_phase_time(
+    const string &phase, double wall_time, double cpu_time) {
+    for (PhaseTime &phase_time : phase_times) {
+        if (phase_time.phase == phase) {
+            phase_time.wall_time += wall_time;
+            phase_time.cpu_time += cpu_time;
+            return;
+        }
+    }
+    phase_times.push_back({phase, wall_time, cpu_time});
+}
+
+void LandmarkFactory::add_phase_time(
+    const string &phase, const PhaseTimer &timer) {
+    add_phase_time(phase, timer.get_wall_time(), timer.get_cpu_time());
+}
+
 bool LandmarkFactory::is_landmark_precondition(const OperatorProxy &op,
                                                const LandmarkNode *lmp) const {
     /* Test whether the landmark is used by the operator as a precondition.
@@ -497,6 +522,72 @@ void LandmarkFactory::discard_all_orderings() {
     }
 }
 
+void LandmarkFactory::discard_noncausal_landmarks(
+    const TaskProxy &task_proxy, const vector<Exploration *> &explorations) {
+    int num_all_landmarks = lm_graph->get_num_landmarks();
+    const LandmarkGraph::Nodes &nodes = lm_graph->get_nodes();
+    // Use char instead of bool, so that threads can write concurrently.
+    vector<char> is_causal(num_all_landmarks);
+    utils::parallel_for(
+        num_all_landmarks, explorations.size(),
+        [&](int i, int thread_index) {
+            is_causal[i] = is_causal_landmark(
+                task_proxy, *explorations[thread_index], *nodes[i]);
+        });
+    unordered_set<const LandmarkNode *> noncausal_landmarks;
+    for (int i = 0; i < num_all_landmarks; ++i) {
+        if (!is_causal[i]) {
+            noncausal_landmarks.insert(nodes[i].get());
+        }
+    }
+    lm_graph->remove_node_if(
+        [&noncausal_landmarks](const LandmarkNode &node) {
+            return noncausal_landmarks.count(&node) != 0;
+        });
+    int num_causal_landmarks = lm_graph->get_num_landmarks();
+    utils::g_log << "Discarded " << num_all_landmarks - num_causal_landmarks
+                 << " non-causal landmarks" << endl;
+}
+
+bool LandmarkFactory::is_causal_landmark(
+    const TaskProxy &task_proxy, Exploration &exploration,
+    const LandmarkNode &landmark) const {
+    /* Test whether the relaxed planning task is unsolvable without using any operator
+       that has "landmark" as a precondition.
+       Similar to LandmarkFactoryRelaxation::relaxed_task_solvable.
+     */
+
+    if (landmark.is_true_in_goal)
+        return true;
+    vector<vector<int>> lvl_var;
+    vector<utils::HashMap<FactPair, int>> lvl_op;
+    // Initialize lvl_var to numeric_limits<int>::max()
+    VariablesProxy variables = task_proxy.get_variables();
+    lvl_var.resize(variables.size());
+    for (VariableProxy var : variables) {
+        lvl_var[var.get_id()].resize(var.get_domain_size(),
+                                     numeric_limits<int>::max());
+    }
+    unordered_set<int> exclude_op_ids;
+    vector<FactPair> exclude_props;
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        if (is_landmark_precondition(op, &landmark)) {
+            exclude_op_ids.insert(op.get_id());
+        }
+    }
+    // Do relaxed exploration
+    exploration.compute_reachability_with_excludes(
+        lvl_var, lvl_op, true, exclude_props, exclude_op_ids, false);
+
+    // Test whether all goal propositions have a level of less than numeric_limits<int>::max()
+    for (FactProxy goal : task_proxy.get_goals())
+        if (lvl_var[goal.get_variable().get_id()][goal.get_value()] ==
+            numeric_limits<int>::max())
+            return true;
+
+    return false;
+}
+
 void LandmarkFactory::mk_acyclic_graph() {
     unordered_set<LandmarkNode *> acyclic_node_set(lm_graph->get_num_landmarks());
     int removed_edges = 0;
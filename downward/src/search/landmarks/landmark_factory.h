@@ -3,10 +3,13 @@
 
 #include "landmark_graph.h"
 
+#include "../utils/timer.h"
+
 #include <list>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -19,6 +22,40 @@ class Options;
 }
 
 namespace landmarks {
+class Exploration;
+
+/*
+  Measure a phase of landmark generation in wall-clock time and in CPU
+  time. Only the wall-clock time shows the effect of using several
+  threads, since the CPU time is summed over all threads.
+*/
+class PhaseTimer {
+    utils::WallClockTimer wall_timer;
+    utils::Timer cpu_timer;
+public:
+    explicit PhaseTimer(bool start = true)
+        : wall_timer(start), cpu_timer(start) {
+    }
+
+    void stop() {
+        wall_timer.stop();
+        cpu_timer.stop();
+    }
+
+    void resume() {
+        wall_timer.resume();
+        cpu_timer.resume();
+    }
+
+    double get_wall_time() const {
+        return wall_timer();
+    }
+
+    double get_cpu_time() const {
+        return cpu_timer();
+    }
+};
+
 /*
   TODO: Change order to private -> protected -> public
    (omitted so far to minimize diff)
@@ -43,6 +80,8 @@ protected:
     const bool disjunctive_landmarks;
     const bool conjunctive_landmarks;
     const bool no_orders;
+    // Number of threads for the parts of the generation that support it.
+    const int num_threads;
 
     /*
       TODO: Make access of member variables of this class consistent (currently,
@@ -56,11 +95,28 @@ protected:
     void discard_disjunctive_landmarks();
     void discard_conjunctive_landmarks();
     void discard_all_orderings();
+    /*
+      Discard the landmarks that are not causal, i.e., the landmarks that
+      are not needed to make the relaxed task solvable. The landmarks are
+      checked with one thread per exploration: thread i of
+      utils::parallel_for uses explorations[i].
+    */
+    void discard_noncausal_landmarks(
+        const TaskProxy &task_proxy,
+        const std::vector<Exploration *> &explorations);
     void approximate_reasonable_orders(
         const TaskProxy &task_proxy, bool obedient_orders);
     void mk_acyclic_graph();
     int calculate_lms_cost() const;
 
+    /*
+      Add time (in seconds) to the given phase of landmark generation.
+      The phase times are printed with the statistics of the graph.
+    */
+    void add_phase_time(
+        const std::string &phase, double wall_time, double cpu_time);
+    void add_phase_time(const std::string &phase, const PhaseTimer &timer);
+
     bool is_landmark_precondition(const OperatorProxy &op, const LandmarkNode *lmp) const;
 
     const std::vector<int> &get_operators_including_eff(const FactPair &eff) const {
@@ -73,7 +129,16 @@ private:
     virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task) = 0;
 
     std::vector<std::vector<std::vector<int>>> operators_eff_lookup;
-
+    struct PhaseTime {
+        std::string phase;
+        double wall_time;
+        double cpu_time;
+    };
+    std::vector<PhaseTime> phase_times;
+
+    bool is_causal_landmark(const TaskProxy &task_proxy,
+                            Exploration &exploration,
+                            const LandmarkNode &landmark) const;
     bool interferes(const TaskProxy &task_proxy,
                     const LandmarkNode *node_a,
                     const LandmarkNode *node_b) const;
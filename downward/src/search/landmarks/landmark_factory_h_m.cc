@@ -9,6 +9,8 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
 using namespace std;
@@ -590,8 +592,16 @@ void LandmarkFactoryHM::initialize(const TaskProxy &task_proxy) {
 
 void LandmarkFactoryHM::generate(const TaskProxy &task_proxy) {
     if (only_causal_landmarks) {
-        Exploration exploration(task_proxy);
-        discard_noncausal_landmarks(task_proxy, exploration);
+        PhaseTimer causal_timer;
+        int num_explorations = min(num_threads, lm_graph->get_num_landmarks());
+        vector<unique_ptr<Exploration>> explorations;
+        vector<Exploration *> thread_explorations;
+        for (int i = 0; i < num_explorations; ++i) {
+            explorations.push_back(utils::make_unique_ptr<Exploration>(task_proxy));
+            thread_explorations.push_back(explorations.back().get());
+        }
+        discard_noncausal_landmarks(task_proxy, thread_explorations);
+        add_phase_time("causality check", causal_timer);
     }
     if (!disjunctive_landmarks)
         discard_disjunctive_landmarks();
@@ -599,6 +609,7 @@ void LandmarkFactoryHM::generate(const TaskProxy &task_proxy) {
         discard_conjunctive_landmarks();
     lm_graph->set_landmark_ids();
 
+    PhaseTimer orderings_timer;
     if (no_orders)
         discard_all_orderings();
     else if (reasonable_orders) {
@@ -608,58 +619,11 @@ void LandmarkFactoryHM::generate(const TaskProxy &task_proxy) {
         approximate_reasonable_orders(task_proxy, true);
     }
     mk_acyclic_graph();
-    calc_achievers(task_proxy);
-}
-
-void LandmarkFactoryHM::discard_noncausal_landmarks(
-    const TaskProxy &task_proxy, Exploration &exploration) {
-    int num_all_landmarks = lm_graph->get_num_landmarks();
-    lm_graph->remove_node_if(
-        [this, &task_proxy, &exploration](const LandmarkNode &node) {
-            return !is_causal_landmark(task_proxy, exploration, node);
-        });
-    int num_causal_landmarks = lm_graph->get_num_landmarks();
-    utils::g_log << "Discarded " << num_all_landmarks - num_causal_landmarks
-                 << " non-causal landmarks" << endl;
-}
-
-bool LandmarkFactoryHM::is_causal_landmark(
-    const TaskProxy &task_proxy, Exploration &exploration,
-    const LandmarkNode &landmark) const {
-    /* Test whether the relaxed planning task is unsolvable without using any operator
-       that has "landmark" as a precondition.
-       Similar to "relaxed_task_solvable" above.
-     */
-
-    if (landmark.is_true_in_goal)
-        return true;
-    vector<vector<int>> lvl_var;
-    vector<utils::HashMap<FactPair, int>> lvl_op;
-    // Initialize lvl_var to numeric_limits<int>::max()
-    VariablesProxy variables = task_proxy.get_variables();
-    lvl_var.resize(variables.size());
-    for (VariableProxy var : variables) {
-        lvl_var[var.get_id()].resize(var.get_domain_size(),
-                                     numeric_limits<int>::max());
-    }
-    unordered_set<int> exclude_op_ids;
-    vector<FactPair> exclude_props;
-    for (OperatorProxy op : task_proxy.get_operators()) {
-        if (is_landmark_precondition(op, &landmark)) {
-            exclude_op_ids.insert(op.get_id());
-        }
-    }
-    // Do relaxed exploration
-    exploration.compute_reachability_with_excludes(
-        lvl_var, lvl_op, true, exclude_props, exclude_op_ids, false);
-
-    // Test whether all goal propositions have a level of less than numeric_limits<int>::max()
-    for (FactProxy goal : task_proxy.get_goals())
-        if (lvl_var[goal.get_variable().get_id()][goal.get_value()] ==
-            numeric_limits<int>::max())
-            return true;
+    add_phase_time("orderings", orderings_timer);
 
-    return false;
+    PhaseTimer achievers_timer;
+    calc_achievers(task_proxy);
+    add_phase_time("achievers", achievers_timer);
 }
 
 void LandmarkFactoryHM::calc_achievers(const TaskProxy &task_proxy) {
@@ -667,55 +631,59 @@ void LandmarkFactoryHM::calc_achievers(const TaskProxy &task_proxy) {
 
     OperatorsProxy operators = task_proxy.get_operators();
     VariablesProxy variables = task_proxy.get_variables();
+    const LandmarkGraph::Nodes &nodes = lm_graph->get_nodes();
     // first_achievers are already filled in by compute_h_m_landmarks
     // here only have to do possible_achievers
-    for (auto &lmn : lm_graph->get_nodes()) {
-        set<int> candidates;
-        // put all possible adders in candidates set
-        for (const FactPair &lm_fact : lmn->facts) {
-            const vector<int> &ops = get_operators_including_eff(lm_fact);
-            candidates.insert(ops.begin(), ops.end());
-        }
+    utils::parallel_for(
+        nodes.size(), num_threads,
+        [&](int i, int) {
+            const unique_ptr<LandmarkNode> &lmn = nodes[i];
+            set<int> candidates;
+            // put all possible adders in candidates set
+            for (const FactPair &lm_fact : lmn->facts) {
+                const vector<int> &ops = get_operators_including_eff(lm_fact);
+                candidates.insert(ops.begin(), ops.end());
+            }
 
-        for (int op_id : candidates) {
-            FluentSet post = get_operator_postcondition(variables.size(), operators[op_id]);
-            FluentSet pre = get_operator_precondition(operators[op_id]);
-            size_t j;
-            for (j = 0; j < lmn->facts.size(); ++j) {
-                const FactPair &lm_fact = lmn->facts[j];
-                // action adds this element of lm as well
-                if (find(post.begin(), post.end(), lm_fact) != post.end())
-                    continue;
-                bool is_mutex = false;
-                for (const FactPair &fluent : post) {
-                    if (variables[fluent.var].get_fact(fluent.value).is_mutex(
-                            variables[lm_fact.var].get_fact(lm_fact.value))) {
-                        is_mutex = true;
+            for (int op_id : candidates) {
+                FluentSet post = get_operator_postcondition(variables.size(), operators[op_id]);
+                FluentSet pre = get_operator_precondition(operators[op_id]);
+                size_t j;
+                for (j = 0; j < lmn->facts.size(); ++j) {
+                    const FactPair &lm_fact = lmn->facts[j];
+                    // action adds this element of lm as well
+                    if (find(post.begin(), post.end(), lm_fact) != post.end())
+                        continue;
+                    bool is_mutex = false;
+                    for (const FactPair &fluent : post) {
+                        if (variables[fluent.var].get_fact(fluent.value).is_mutex(
+                                variables[lm_fact.var].get_fact(lm_fact.value))) {
+                            is_mutex = true;
+                            break;
+                        }
+                    }
+                    if (is_mutex) {
                         break;
                     }
-                }
-                if (is_mutex) {
-                    break;
-                }
-                for (const FactPair &fluent : pre) {
-                    // we know that lm_val is not added by the operator
-                    // so if it incompatible with the pc, this can't be an achiever
-                    if (variables[fluent.var].get_fact(fluent.value).is_mutex(
-                            variables[lm_fact.var].get_fact(lm_fact.value))) {
-                        is_mutex = true;
+                    for (const FactPair &fluent : pre) {
+                        // we know that lm_val is not added by the operator
+                        // so if it incompatible with the pc, this can't be an achiever
+                        if (variables[fluent.var].get_fact(fluent.value).is_mutex(
+                                variables[lm_fact.var].get_fact(lm_fact.value))) {
+                            is_mutex = true;
+                            break;
+                        }
+                    }
+                    if (is_mutex) {
                         break;
                     }
                 }
-                if (is_mutex) {
-                    break;
+                if (j == lmn->facts.size()) {
+                    // not inconsistent with any of the other landmark fluents
+                    lmn->possible_achievers.insert(op_id);
                 }
             }
-            if (j == lmn->facts.size()) {
-                // not inconsistent with any of the other landmark fluents
-                lmn->possible_achievers.insert(op_id);
-            }
-        }
-    }
+        });
 }
 
 void LandmarkFactoryHM::free_unneeded_memory() {
@@ -976,6 +944,7 @@ void LandmarkFactoryHM::add_lm_node(int set_index, bool goal) {
 void LandmarkFactoryHM::generate_landmarks(
     const shared_ptr<AbstractTask> &task) {
     TaskProxy task_proxy(*task);
+    PhaseTimer discovery_timer;
     initialize(task_proxy);
     compute_h_m_landmarks(task_proxy);
     // now construct landmarks graph
@@ -1041,6 +1010,7 @@ void LandmarkFactoryHM::generate_landmarks(
         }
     }
     free_unneeded_memory();
+    add_phase_time("discovery", discovery_timer);
 
     generate(task_proxy);
 }
@@ -1056,10 +1026,15 @@ static shared_ptr<LandmarkFactory> _parse(OptionParser &parser) {
         "Keyder, Richter & Helmert (ECAI 2010).");
     parser.document_note(
         "Relevant options",
-        "m, reasonable_orders, conjunctive_landmarks, no_orders");
+        "m, reasonable_orders, conjunctive_landmarks, no_orders, threads");
     parser.add_option<int>(
         "m", "subset size (if unsure, use the default of 2)", "2");
     _add_options_to_parser(parser);
+    utils::add_threads_option_to_parser(
+        parser,
+        "number of threads for checking causality and computing the "
+        "achievers of the landmarks (the landmark graph does not depend "
+        "on this number)");
     Options opts = parser.parse();
     if (parser.help_mode())
         return nullptr;
@@ -2,25 +2,59 @@
 
 #include "exploration.h"
 
+#include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/parallel.h"
+
+#include <unordered_set>
+
 using namespace std;
 
 namespace landmarks {
+LandmarkFactoryRelaxation::LandmarkFactoryRelaxation(const options::Options &opts)
+    : LandmarkFactory(opts) {
+}
+
+LandmarkFactoryRelaxation::~LandmarkFactoryRelaxation() {
+}
+
 void LandmarkFactoryRelaxation::generate_landmarks(const shared_ptr<AbstractTask> &task) {
     TaskProxy task_proxy(*task);
     Exploration exploration(task_proxy);
+    for (int i = 1; i < num_threads; ++i) {
+        thread_explorations.push_back(
+            utils::make_unique_ptr<Exploration>(task_proxy));
+    }
     generate_relaxed_landmarks(task, exploration);
     generate(task_proxy, exploration);
+    thread_explorations.clear();
+}
+
+Exploration &LandmarkFactoryRelaxation::get_exploration(
+    Exploration &exploration, int thread_index) {
+    if (thread_index == 0) {
+        return exploration;
+    }
+    return *thread_explorations[thread_index - 1];
 }
 
 void LandmarkFactoryRelaxation::generate(const TaskProxy &task_proxy, Exploration &exploration) {
-    if (only_causal_landmarks)
-        discard_noncausal_landmarks(task_proxy, exploration);
+    if (only_causal_landmarks) {
+        PhaseTimer causal_timer;
+        vector<Exploration *> explorations;
+        for (int i = 0; i < num_threads; ++i) {
+            explorations.push_back(&get_exploration(exploration, i));
+        }
+        discard_noncausal_landmarks(task_proxy, explorations);
+        add_phase_time("causality check", causal_timer);
+    }
     if (!disjunctive_landmarks)
         discard_disjunctive_landmarks();
     if (!conjunctive_landmarks)
         discard_conjunctive_landmarks();
     lm_graph->set_landmark_ids();
 
+    PhaseTimer orderings_timer;
     if (no_orders)
         discard_all_orderings();
     else if (reasonable_orders) {
@@ -30,83 +64,42 @@ void LandmarkFactoryRelaxation::generate(const TaskProxy &task_proxy, Exploratio
         approximate_reasonable_orders(task_proxy, true);
     }
     mk_acyclic_graph();
-    calc_achievers(task_proxy, exploration);
-}
-
-void LandmarkFactoryRelaxation::discard_noncausal_landmarks(
-    const TaskProxy &task_proxy, Exploration &exploration) {
-    int num_all_landmarks = lm_graph->get_num_landmarks();
-    lm_graph->remove_node_if(
-        [this, &task_proxy, &exploration](const LandmarkNode &node) {
-            return !is_causal_landmark(task_proxy, exploration, node);
-        });
-    int num_causal_landmarks = lm_graph->get_num_landmarks();
-    utils::g_log << "Discarded " << num_all_landmarks - num_causal_landmarks
-                 << " non-causal landmarks" << endl;
-}
-
-bool LandmarkFactoryRelaxation::is_causal_landmark(
-    const TaskProxy &task_proxy, Exploration &exploration,
-    const LandmarkNode &landmark) const {
-    /* Test whether the relaxed planning task is unsolvable without using any operator
-       that has "landmark" as a precondition.
-       Similar to "relaxed_task_solvable" above.
-     */
-
-    if (landmark.is_true_in_goal)
-        return true;
-    vector<vector<int>> lvl_var;
-    vector<utils::HashMap<FactPair, int>> lvl_op;
-    // Initialize lvl_var to numeric_limits<int>::max()
-    VariablesProxy variables = task_proxy.get_variables();
-    lvl_var.resize(variables.size());
-    for (VariableProxy var : variables) {
-        lvl_var[var.get_id()].resize(var.get_domain_size(),
-                                     numeric_limits<int>::max());
-    }
-    unordered_set<int> exclude_op_ids;
-    vector<FactPair> exclude_props;
-    for (OperatorProxy op : task_proxy.get_operators()) {
-        if (is_landmark_precondition(op, &landmark)) {
-            exclude_op_ids.insert(op.get_id());
-        }
-    }
-    // Do relaxed exploration
-    exploration.compute_reachability_with_excludes(
-        lvl_var, lvl_op, true, exclude_props, exclude_op_ids, false);
-
-    // Test whether all goal propositions have a level of less than numeric_limits<int>::max()
-    for (FactProxy goal : task_proxy.get_goals())
-        if (lvl_var[goal.get_variable().get_id()][goal.get_value()] ==
-            numeric_limits<int>::max())
-            return true;
+    add_phase_time("orderings", orderings_timer);
 
-    return false;
+    PhaseTimer achievers_timer;
+    calc_achievers(task_proxy, exploration);
+    add_phase_time("achievers", achievers_timer);
 }
 
 void LandmarkFactoryRelaxation::calc_achievers(const TaskProxy &task_proxy, Exploration &exploration) {
     VariablesProxy variables = task_proxy.get_variables();
-    for (auto &lmn : lm_graph->get_nodes()) {
-        for (const FactPair &lm_fact : lmn->facts) {
-            const vector<int> &ops = get_operators_including_eff(lm_fact);
-            lmn->possible_achievers.insert(ops.begin(), ops.end());
-
-            if (variables[lm_fact.var].is_derived())
-                lmn->is_derived = true;
-        }
+    const LandmarkGraph::Nodes &nodes = lm_graph->get_nodes();
+    // The achievers of each landmark only depend on the landmark itself.
+    utils::parallel_for(
+        nodes.size(), num_threads,
+        [&](int i, int thread_index) {
+            const unique_ptr<LandmarkNode> &lmn = nodes[i];
+            for (const FactPair &lm_fact : lmn->facts) {
+                const vector<int> &ops = get_operators_including_eff(lm_fact);
+                lmn->possible_achievers.insert(ops.begin(), ops.end());
+
+                if (variables[lm_fact.var].is_derived())
+                    lmn->is_derived = true;
+            }
 
-        vector<vector<int>> lvl_var;
-        vector<utils::HashMap<FactPair, int>> lvl_op;
-        relaxed_task_solvable(task_proxy, exploration, lvl_var, lvl_op, true, lmn.get());
+            vector<vector<int>> lvl_var;
+            vector<utils::HashMap<FactPair, int>> lvl_op;
+            relaxed_task_solvable(task_proxy, get_exploration(exploration, thread_index),
+                                  lvl_var, lvl_op, true, lmn.get());
 
-        for (int op_or_axom_id : lmn->possible_achievers) {
-            OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axom_id);
+            for (int op_or_axom_id : lmn->possible_achievers) {
+                OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axom_id);
 
-            if (_possibly_reaches_lm(op, lvl_var, lmn.get())) {
-                lmn->first_achievers.insert(op_or_axom_id);
+                if (_possibly_reaches_lm(op, lvl_var, lmn.get())) {
+                    lmn->first_achievers.insert(op_or_axom_id);
+                }
             }
-        }
-    }
+        });
 }
 
 bool LandmarkFactoryRelaxation::relaxed_task_solvable(
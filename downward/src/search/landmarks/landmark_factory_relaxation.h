@@ -3,13 +3,25 @@
 
 #include "landmark_factory.h"
 
+#include <memory>
+#include <vector>
+
 namespace landmarks {
 class Exploration;
 
 class LandmarkFactoryRelaxation : public LandmarkFactory {
+    // Explorations for the threads other than the main thread.
+    std::vector<std::unique_ptr<Exploration>> thread_explorations;
+
 protected:
-    explicit LandmarkFactoryRelaxation(const options::Options &opts)
-        : LandmarkFactory(opts) {}
+    explicit LandmarkFactoryRelaxation(const options::Options &opts);
+    virtual ~LandmarkFactoryRelaxation() override;
+
+    /*
+      Return the exploration that the given thread of utils::parallel_for
+      may use, where exploration is the one of the main thread.
+    */
+    Exploration &get_exploration(Exploration &exploration, int thread_index);
 
     bool relaxed_task_solvable(const TaskProxy &task_proxy, Exploration &exploration,
                                bool level_out,
@@ -29,14 +41,6 @@ private:
                                             Exploration &exploration) = 0;
     void generate(const TaskProxy &task_proxy, Exploration &exploration);
 
-    // TODO: this is duplicated here and in LandmarkFactoryHM
-    void discard_noncausal_landmarks(const TaskProxy &task_proxy,
-                                     Exploration &exploration);
-    // TODO: this is duplicated here and in LandmarkFactoryHM
-    bool is_causal_landmark(const TaskProxy &task_proxy,
-                            Exploration &exploration,
-                            const LandmarkNode &landmark) const;
-
     void calc_achievers(const TaskProxy &task_proxy, Exploration &exploration);
     bool achieves_non_conditional(const OperatorProxy &o,
                                   const LandmarkNode *lmp) const;
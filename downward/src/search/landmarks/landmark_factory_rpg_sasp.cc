@@ -1,5 +1,6 @@
 #include "landmark_factory_rpg_sasp.h"
 
+#include "exploration.h"
 #include "landmark_graph.h"
 #include "util.h"
 
@@ -8,6 +9,7 @@
 #include "../task_proxy.h"
 
 #include "../utils/logging.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
 #include <cassert>
@@ -411,12 +413,71 @@ void LandmarkFactoryRpgSasp::compute_disjunctive_preconditions(
     }
 }
 
+void LandmarkFactoryRpgSasp::compute_lvl_var(
+    const TaskProxy &task_proxy, Exploration &exploration,
+    const State &initial_state, const LandmarkNode *bp,
+    vector<vector<int>> &lvl_var) {
+    if (num_threads > 1) {
+        auto it = lvl_var_cache.find(bp->facts);
+        if (it == lvl_var_cache.end()) {
+            precompute_lvl_vars(task_proxy, exploration, initial_state, bp);
+            it = lvl_var_cache.find(bp->facts);
+        }
+        assert(it != lvl_var_cache.end());
+        lvl_var = move(it->second);
+        lvl_var_cache.erase(it);
+    } else {
+        vector<utils::HashMap<FactPair, int>> lvl_op;
+        relaxed_task_solvable(task_proxy, exploration, lvl_var, lvl_op, true, bp);
+    }
+}
+
+void LandmarkFactoryRpgSasp::precompute_lvl_vars(
+    const TaskProxy &task_proxy, Exploration &exploration,
+    const State &initial_state, const LandmarkNode *bp) {
+    /*
+      Compute the explorations for bp and the next open landmarks that
+      need one. We limit the number of landmarks to bound the memory
+      for the stored results.
+    */
+    const int max_landmarks = 8 * num_threads;
+    vector<const LandmarkNode *> landmarks = {bp};
+    utils::HashSet<vector<FactPair>> scheduled = {bp->facts};
+    for (const LandmarkNode *node : open_landmarks) {
+        if (static_cast<int>(landmarks.size()) == max_landmarks) {
+            break;
+        }
+        if (!node->is_true_in_state(initial_state) &&
+            !lvl_var_cache.count(node->facts) &&
+            scheduled.insert(node->facts).second) {
+            landmarks.push_back(node);
+        }
+    }
+
+    vector<vector<vector<int>>> lvl_vars(landmarks.size());
+    utils::parallel_for(
+        landmarks.size(), num_threads,
+        [&](int i, int thread_index) {
+            vector<utils::HashMap<FactPair, int>> lvl_op;
+            relaxed_task_solvable(
+                task_proxy, get_exploration(exploration, thread_index),
+                lvl_vars[i], lvl_op, true, landmarks[i]);
+        });
+    for (size_t i = 0; i < landmarks.size(); ++i) {
+        lvl_var_cache[landmarks[i]->facts] = move(lvl_vars[i]);
+    }
+}
+
 void LandmarkFactoryRpgSasp::generate_relaxed_landmarks(
     const shared_ptr<AbstractTask> &task, Exploration &exploration) {
     TaskProxy task_proxy(*task);
     utils::g_log << "Generating landmarks using the RPG/SAS+ approach\n";
+    PhaseTimer discovery_timer;
+    PhaseTimer disjunctive_timer(false);
     build_dtg_successors(task_proxy);
+    disjunctive_timer.resume();
     build_disjunction_classes(task_proxy);
+    disjunctive_timer.stop();
 
     for (FactProxy goal : task_proxy.get_goals()) {
         LandmarkNode &lmn = lm_graph->add_simple_landmark(goal.get_pair());
@@ -436,8 +497,7 @@ void LandmarkFactoryRpgSasp::generate_relaxed_landmarks(
             // relaxed plan that propositions are achieved (in lvl_var) and operators
             // applied (in lvl_ops).
             vector<vector<int>> lvl_var;
-            vector<utils::HashMap<FactPair, int>> lvl_op;
-            relaxed_task_solvable(task_proxy, exploration, lvl_var, lvl_op, true, bp);
+            compute_lvl_var(task_proxy, exploration, initial_state, bp, lvl_var);
             // Use this information to determine all operators that can possibly achieve bp
             // for the first time, and collect any precondition propositions that all such
             // operators share (if there are any).
@@ -453,15 +513,26 @@ void LandmarkFactoryRpgSasp::generate_relaxed_landmarks(
             bp->cost = min_cost_for_landmark(task_proxy, bp, lvl_var);
 
             // Process achieving operators again to find disj. LMs
+            disjunctive_timer.resume();
             vector<set<FactPair>> disjunctive_pre;
             compute_disjunctive_preconditions(task_proxy, disjunctive_pre, lvl_var, bp);
             for (const auto &preconditions : disjunctive_pre)
                 if (preconditions.size() < 5) { // We don't want disj. LMs to get too big
                     found_disj_lm_and_order(task_proxy, preconditions, *bp, EdgeType::GREEDY_NECESSARY);
                 }
+            disjunctive_timer.stop();
         }
     }
+    lvl_var_cache.clear();
+    add_phase_time(
+        "discovery",
+        discovery_timer.get_wall_time() - disjunctive_timer.get_wall_time(),
+        discovery_timer.get_cpu_time() - disjunctive_timer.get_cpu_time());
+    add_phase_time("disjunctive landmarks", disjunctive_timer);
+
+    PhaseTimer orderings_timer;
     add_lm_forward_orders();
+    add_phase_time("orderings", orderings_timer);
 }
 
 void LandmarkFactoryRpgSasp::approximate_lookahead_orders(
@@ -605,8 +676,13 @@ static shared_ptr<LandmarkFactory> _parse(OptionParser &parser) {
     parser.document_note(
         "Relevant Options",
         "reasonable_orders, only_causal_landmarks, "
-        "disjunctive_landmarks, no_orders");
+        "disjunctive_landmarks, no_orders, threads");
     _add_options_to_parser(parser);
+    utils::add_threads_option_to_parser(
+        parser,
+        "number of threads for the relaxed explorations that find "
+        "landmarks, check their causality and compute their achievers "
+        "(the landmark graph does not depend on this number)");
 
     Options opts = parser.parse();
 
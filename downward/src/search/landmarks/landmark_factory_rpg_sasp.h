@@ -14,6 +14,15 @@ class LandmarkFactoryRpgSasp : public LandmarkFactoryRelaxation {
 
     std::map<LandmarkNode *, utils::HashSet<FactPair>> forward_orders;
 
+    /*
+      With several threads, the relaxed explorations excluding the open
+      landmarks are computed in parallel before the landmarks are
+      processed (in the same order as with a single thread). The results
+      only depend on the facts of the excluded landmark, so we store
+      them by these facts, which stay valid if a landmark is replaced.
+    */
+    utils::HashMap<std::vector<FactPair>, std::vector<std::vector<int>>> lvl_var_cache;
+
     // dtg_successors[var_id][val] contains all successor values of val in the
     // domain transition graph for the variable
     std::vector<std::vector<std::unordered_set<int>>> dtg_successors;
@@ -38,6 +47,12 @@ class LandmarkFactoryRpgSasp : public LandmarkFactoryRelaxation {
         std::vector<std::set<FactPair>> &disjunctive_pre,
         std::vector<std::vector<int>> &lvl_var, LandmarkNode *bp);
 
+    void compute_lvl_var(const TaskProxy &task_proxy, Exploration &exploration,
+                         const State &initial_state, const LandmarkNode *bp,
+                         std::vector<std::vector<int>> &lvl_var);
+    void precompute_lvl_vars(const TaskProxy &task_proxy, Exploration &exploration,
+                             const State &initial_state, const LandmarkNode *bp);
+
     int min_cost_for_landmark(const TaskProxy &task_proxy,
                               LandmarkNode *bp,
                               std::vector<std::vector<int>> &lvl_var);
@@ -2,8 +2,12 @@
 
 #include "landmark_graph.h"
 
+#include "../task_proxy.h"
+
 #include "../utils/logging.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace landmarks {
@@ -11,10 +15,51 @@ namespace landmarks {
   By default we mark all landmarks as reached, since we do an intersection when
   computing new landmark information.
 */
-LandmarkStatusManager::LandmarkStatusManager(LandmarkGraph &graph)
-    : reached_lms(vector<bool>(graph.get_num_landmarks(), true)),
+LandmarkStatusManager::LandmarkStatusManager(
+    LandmarkGraph &graph, const TaskProxy &task_proxy, bool incremental)
+    : reached_lms(graph.get_num_landmarks(), true),
       lm_status(graph.get_num_landmarks(), lm_not_reached),
-      lm_graph(graph) {
+      lm_graph(graph),
+      incremental(incremental) {
+    if (incremental) {
+        compute_touched_landmarks(task_proxy);
+    }
+}
+
+void LandmarkStatusManager::compute_touched_landmarks(
+    const TaskProxy &task_proxy) {
+    VariablesProxy variables = task_proxy.get_variables();
+    vector<vector<vector<int>>> landmarks_by_fact(variables.size());
+    for (VariableProxy var : variables) {
+        landmarks_by_fact[var.get_id()].resize(var.get_domain_size());
+    }
+    for (auto &node : lm_graph.get_nodes()) {
+        int id = node->get_id();
+        bool on_derived_variable = false;
+        for (const FactPair &fact : node->facts) {
+            landmarks_by_fact[fact.var][fact.value].push_back(id);
+            if (variables[fact.var].is_derived()) {
+                on_derived_variable = true;
+            }
+        }
+        if (on_derived_variable) {
+            derived_landmarks.push_back(id);
+        }
+    }
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    landmarks_touched_by_operator.resize(operators.size());
+    for (OperatorProxy op : operators) {
+        vector<int> &touched = landmarks_touched_by_operator[op.get_id()];
+        for (EffectProxy effect : op.get_effects()) {
+            FactPair fact = effect.get_fact().get_pair();
+            const vector<int> &lms = landmarks_by_fact[fact.var][fact.value];
+            touched.insert(touched.end(), lms.begin(), lms.end());
+        }
+        sort(touched.begin(), touched.end());
+        touched.erase(unique(touched.begin(), touched.end()), touched.end());
+        touched.shrink_to_fit();
+    }
 }
 
 landmark_status LandmarkStatusManager::get_landmark_status(
@@ -65,12 +110,22 @@ void LandmarkStatusManager::set_landmarks_for_initial_state(
             }
         }
     }
+    if (incremental) {
+        /*
+          Establish the invariant of the incremental mode (see header)
+          for the initial state.
+        */
+        for (int id = 0; id < lm_graph.get_num_landmarks(); ++id) {
+            open_landmarks.push_back(id);
+        }
+        mark_reached_leaves(initial_state, reached);
+    }
     utils::g_log << inserted << " initial landmarks, "
                  << num_goal_lms << " goal landmarks" << endl;
 }
 
 bool LandmarkStatusManager::update_reached_lms(const State &parent_ancestor_state,
-                                               OperatorID,
+                                               OperatorID op_id,
                                                const State &ancestor_state) {
     if (ancestor_state == parent_ancestor_state) {
         // This can happen, e.g., in Satellite-01.
@@ -84,6 +139,19 @@ bool LandmarkStatusManager::update_reached_lms(const State &parent_ancestor_stat
     assert(reached.size() == num_landmarks);
     assert(parent_reached.size() == num_landmarks);
 
+    if (incremental) {
+        assert(open_landmarks.empty());
+        parent_reached.collect_bits_not_in(reached, open_landmarks);
+        reached.intersect(parent_reached);
+        const vector<int> &touched =
+            landmarks_touched_by_operator[op_id.get_index()];
+        open_landmarks.insert(open_landmarks.end(), touched.begin(), touched.end());
+        open_landmarks.insert(open_landmarks.end(),
+                              derived_landmarks.begin(), derived_landmarks.end());
+        mark_reached_leaves(ancestor_state, reached);
+        return true;
+    }
+
     /*
        Set all landmarks not reached by this parent as "not reached".
        Over multiple paths, this has the effect of computing the intersection
@@ -112,6 +180,25 @@ bool LandmarkStatusManager::update_reached_lms(const State &parent_ancestor_stat
     return true;
 }
 
+void LandmarkStatusManager::mark_reached_leaves(
+    const State &ancestor_state, BitsetView &reached) {
+    while (!open_landmarks.empty()) {
+        int id = open_landmarks.back();
+        open_landmarks.pop_back();
+        if (reached.test(id)) {
+            continue;
+        }
+        LandmarkNode *node = lm_graph.get_landmark(id);
+        if (node->is_true_in_state(ancestor_state) &&
+            landmark_is_leaf(*node, reached)) {
+            reached.set(id);
+            for (const auto &child : node->children) {
+                open_landmarks.push_back(child.first->get_id());
+            }
+        }
+    }
+}
+
 void LandmarkStatusManager::update_lm_status(const State &ancestor_state) {
     const BitsetView reached = get_reached_landmarks(ancestor_state);
 
@@ -3,22 +3,54 @@
 
 #include "../per_state_bitset.h"
 
+#include <vector>
+
+class TaskProxy;
+
 namespace landmarks {
 class LandmarkGraph;
 class LandmarkNode;
 
 enum landmark_status {lm_reached = 0, lm_not_reached = 1, lm_needed_again = 2};
 
+/*
+  In incremental mode, update_reached_lms only looks at the landmarks
+  that can have become reached in the new state instead of all
+  landmarks. These are the landmarks containing an effect fact of the
+  operator (precomputed per operator), landmarks on derived variables,
+  landmarks that are reached in the parent but were missing from the
+  reached set of the state before this update, and the children of
+  landmarks marked as reached in this update.
+
+  This relies on the invariant that after each update no landmark that
+  is true in the state and whose parents are all reached is missing
+  from the reached set. The non-incremental update considers the
+  landmarks in order of their IDs and hence does not guarantee this
+  invariant: a landmark whose parent is reached in the same update
+  only counts as reached if it has a larger ID than the parent.
+  Therefore, the two modes can compute different reached sets.
+*/
 class LandmarkStatusManager {
     PerStateBitset reached_lms;
     std::vector<landmark_status> lm_status;
 
     LandmarkGraph &lm_graph;
 
+    const bool incremental;
+    // Landmarks containing an effect fact of the operator (incremental mode).
+    std::vector<std::vector<int>> landmarks_touched_by_operator;
+    // Landmarks with facts on derived variables (incremental mode).
+    std::vector<int> derived_landmarks;
+    std::vector<int> open_landmarks;
+
+    void compute_touched_landmarks(const TaskProxy &task_proxy);
+    void mark_reached_leaves(const State &ancestor_state, BitsetView &reached);
+
     bool landmark_is_leaf(const LandmarkNode &node, const BitsetView &reached) const;
     bool landmark_needed_again(int id, const State &state);
 public:
-    explicit LandmarkStatusManager(LandmarkGraph &graph);
+    LandmarkStatusManager(
+        LandmarkGraph &graph, const TaskProxy &task_proxy, bool incremental);
 
     BitsetView get_reached_landmarks(const State &state);
 
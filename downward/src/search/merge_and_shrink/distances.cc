@@ -6,12 +6,20 @@
 #include "../algorithms/priority_queues.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
-#include <deque>
+#include <cstdint>
+#include <numeric>
 
 using namespace std;
 
 namespace merge_and_shrink {
+/*
+  Label costs up to this bound use a bucket queue for computing
+  general-cost distances, larger costs use a heap.
+*/
+static const int MAX_COST_FOR_BUCKET_QUEUE = 1000;
+
 const int Distances::DISTANCE_UNKNOWN;
 
 Distances::Distances(const TransitionSystem &transition_system)
@@ -36,8 +44,7 @@ bool Distances::is_unit_cost() const {
       previous implementation in transition_system.cc because that
       would require access to more attributes. One nice thing about it
       is that it gets at the label cost information in the same way
-      that the actual shortest-path algorithms (e.g.
-      compute_goal_distances_general_cost) do.
+      that the actual shortest-path algorithms (see build_graph) do.
     */
     for (GroupAndTransitions gat : transition_system) {
         const LabelGroup &label_group = gat.label_group;
@@ -47,60 +54,184 @@ bool Distances::is_unit_cost() const {
     return true;
 }
 
-static void breadth_first_search(
-    const vector<vector<int>> &graph, deque<int> &queue,
-    vector<int> &distances) {
-    while (!queue.empty()) {
-        int state = queue.front();
-        queue.pop_front();
-        for (size_t i = 0; i < graph[state].size(); ++i) {
-            int successor = graph[state][i];
-            if (distances[successor] > distances[state] + 1) {
-                distances[successor] = distances[state] + 1;
-                queue.push_back(successor);
-            }
-        }
+int Distances::get_max_label_cost() const {
+    int max_cost = 0;
+    for (GroupAndTransitions gat : transition_system) {
+        max_cost = max(max_cost, gat.label_group.get_cost());
     }
+    return max_cost;
 }
 
-void Distances::compute_init_distances_unit_cost() {
-    vector<vector<int>> forward_graph(get_num_states());
+/*
+  Adjacency lists of all states in compressed form: the edges of state s
+  are stored at the positions [offsets[s], offsets[s + 1]) of neighbors
+  and costs. Costs are only stored for general-cost searches.
+*/
+struct Graph {
+    vector<int> offsets;
+    vector<int> neighbors;
+    vector<int> costs;
+
+    int get_num_edges(int state) const {
+        return offsets[state + 1] - offsets[state];
+    }
+};
+
+static Graph build_graph(
+    const TransitionSystem &transition_system, bool backward, bool with_costs) {
+    int num_states = transition_system.get_size();
+    Graph graph;
+    graph.offsets.assign(num_states + 1, 0);
     for (GroupAndTransitions gat : transition_system) {
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            forward_graph[transition.src].push_back(transition.target);
+        for (const Transition &transition : gat.transitions) {
+            int from = backward ? transition.target : transition.src;
+            ++graph.offsets[from + 1];
         }
     }
+    partial_sum(graph.offsets.begin(), graph.offsets.end(), graph.offsets.begin());
 
-    deque<int> queue;
-    queue.push_back(transition_system.get_init_state());
-    init_distances[transition_system.get_init_state()] = 0;
-    breadth_first_search(forward_graph, queue, init_distances);
+    int num_edges = graph.offsets.back();
+    graph.neighbors.resize(num_edges);
+    if (with_costs) {
+        graph.costs.resize(num_edges);
+    }
+    vector<int> next_edge(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (GroupAndTransitions gat : transition_system) {
+        int cost = gat.label_group.get_cost();
+        for (const Transition &transition : gat.transitions) {
+            int from = backward ? transition.target : transition.src;
+            int to = backward ? transition.src : transition.target;
+            int edge = next_edge[from]++;
+            graph.neighbors[edge] = to;
+            if (with_costs) {
+                graph.costs[edge] = cost;
+            }
+        }
+    }
+    return graph;
 }
 
-void Distances::compute_goal_distances_unit_cost() {
-    vector<vector<int>> backward_graph(get_num_states());
-    for (GroupAndTransitions gat : transition_system) {
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            backward_graph[transition.target].push_back(transition.src);
+/*
+  Direction-optimizing breadth-first search (Beamer, Asanovic and
+  Patterson, SC 2012). A top-down step expands all states of the current
+  layer. A bottom-up step checks for every unreached state whether one of
+  its predecessors (its edges in reverse_graph) lies in the current
+  layer, which is cheaper if the layer has more edges than the unreached
+  part of the graph. Both steps compute the same next layer (up to
+  order), so the distances do not depend on the direction.
+*/
+static void breadth_first_search(
+    const Graph &graph, const Graph &reverse_graph,
+    vector<int> &layer, vector<int> &distances) {
+    // Parameters for switching the direction, as suggested by Beamer et al.
+    const int alpha = 14;
+    const int beta = 24;
+    int num_states = distances.size();
+
+    // Number of edges in reverse_graph that start in unreached states.
+    int64_t unreached_edges = reverse_graph.neighbors.size();
+    for (int state : layer) {
+        distances[state] = 0;
+        unreached_edges -= reverse_graph.get_num_edges(state);
+    }
+
+    bool bottom_up = false;
+    vector<int> next_layer;
+    for (int distance = 0; !layer.empty(); ++distance) {
+        if (bottom_up) {
+            if (static_cast<int64_t>(layer.size()) * beta < num_states) {
+                bottom_up = false;
+            }
+        } else {
+            int64_t layer_edges = 0;
+            for (int state : layer) {
+                layer_edges += graph.get_num_edges(state);
+            }
+            if (layer_edges * alpha > unreached_edges) {
+                bottom_up = true;
+            }
+        }
+
+        next_layer.clear();
+        if (bottom_up) {
+            for (int state = 0; state < num_states; ++state) {
+                if (distances[state] != INF)
+                    continue;
+                for (int i = reverse_graph.offsets[state];
+                     i < reverse_graph.offsets[state + 1]; ++i) {
+                    if (distances[reverse_graph.neighbors[i]] == distance) {
+                        distances[state] = distance + 1;
+                        next_layer.push_back(state);
+                        break;
+                    }
+                }
+            }
+        } else {
+            for (int state : layer) {
+                for (int i = graph.offsets[state]; i < graph.offsets[state + 1]; ++i) {
+                    int successor = graph.neighbors[i];
+                    if (distances[successor] == INF) {
+                        distances[successor] = distance + 1;
+                        next_layer.push_back(successor);
+                    }
+                }
+            }
         }
+
+        for (int state : next_layer) {
+            unreached_edges -= reverse_graph.get_num_edges(state);
+        }
+        layer.swap(next_layer);
     }
+}
 
-    deque<int> queue;
-    for (int state = 0; state < get_num_states(); ++state) {
-        if (transition_system.is_goal_state(state)) {
-            goal_distances[state] = 0;
-            queue.push_back(state);
+/*
+  Dijkstra's algorithm with a circular bucket queue (Dial's algorithm).
+  All queued distances lie in [d, d + max_cost] for the currently
+  expanded distance d, so max_cost + 1 buckets suffice.
+*/
+static void dial_search(
+    const Graph &graph, int max_cost,
+    const vector<int> &initial_states, vector<int> &distances) {
+    int num_buckets = max_cost + 1;
+    vector<vector<int>> buckets(num_buckets);
+    int num_queued = 0;
+    for (int state : initial_states) {
+        distances[state] = 0;
+        buckets[0].push_back(state);
+        ++num_queued;
+    }
+    for (int distance = 0; num_queued > 0; ++distance) {
+        vector<int> &bucket = buckets[distance % num_buckets];
+        // Zero-cost edges add states to the current bucket.
+        while (!bucket.empty()) {
+            int state = bucket.back();
+            bucket.pop_back();
+            --num_queued;
+            assert(distances[state] <= distance);
+            if (distances[state] < distance)
+                continue;
+            for (int i = graph.offsets[state]; i < graph.offsets[state + 1]; ++i) {
+                int successor = graph.neighbors[i];
+                int successor_distance = distance + graph.costs[i];
+                if (distances[successor] > successor_distance) {
+                    distances[successor] = successor_distance;
+                    buckets[successor_distance % num_buckets].push_back(successor);
+                    ++num_queued;
+                }
+            }
         }
     }
-    breadth_first_search(backward_graph, queue, goal_distances);
 }
 
 static void dijkstra_search(
-    const vector<vector<pair<int, int>>> &graph,
-    priority_queues::AdaptiveQueue<int> &queue,
+    const Graph &graph, const vector<int> &initial_states,
     vector<int> &distances) {
+    priority_queues::AdaptiveQueue<int> queue;
+    for (int state : initial_states) {
+        distances[state] = 0;
+        queue.push(0, state);
+    }
     while (!queue.empty()) {
         pair<int, int> top_pair = queue.pop();
         int distance = top_pair.first;
@@ -109,11 +240,9 @@ static void dijkstra_search(
         assert(state_distance <= distance);
         if (state_distance < distance)
             continue;
-        for (size_t i = 0; i < graph[state].size(); ++i) {
-            const pair<int, int> &transition = graph[state][i];
-            int successor = transition.first;
-            int cost = transition.second;
-            int successor_cost = state_distance + cost;
+        for (int i = graph.offsets[state]; i < graph.offsets[state + 1]; ++i) {
+            int successor = graph.neighbors[i];
+            int successor_cost = state_distance + graph.costs[i];
             if (distances[successor] > successor_cost) {
                 distances[successor] = successor_cost;
                 queue.push(successor_cost, successor);
@@ -122,48 +251,14 @@ static void dijkstra_search(
     }
 }
 
-void Distances::compute_init_distances_general_cost() {
-    vector<vector<pair<int, int>>> forward_graph(get_num_states());
-    for (GroupAndTransitions gat : transition_system) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        int cost = label_group.get_cost();
-        for (const Transition &transition : transitions) {
-            forward_graph[transition.src].push_back(
-                make_pair(transition.target, cost));
-        }
-    }
-
-    // TODO: Reuse the same queue for multiple computations to save speed?
-    //       Also see compute_goal_distances_general_cost.
-    priority_queues::AdaptiveQueue<int> queue;
-    init_distances[transition_system.get_init_state()] = 0;
-    queue.push(0, transition_system.get_init_state());
-    dijkstra_search(forward_graph, queue, init_distances);
-}
-
-void Distances::compute_goal_distances_general_cost() {
-    vector<vector<pair<int, int>>> backward_graph(get_num_states());
-    for (GroupAndTransitions gat : transition_system) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        int cost = label_group.get_cost();
-        for (const Transition &transition : transitions) {
-            backward_graph[transition.target].push_back(
-                make_pair(transition.src, cost));
-        }
-    }
-
-    // TODO: Reuse the same queue for multiple computations to save speed?
-    //       Also see compute_init_distances_general_cost.
-    priority_queues::AdaptiveQueue<int> queue;
-    for (int state = 0; state < get_num_states(); ++state) {
-        if (transition_system.is_goal_state(state)) {
-            goal_distances[state] = 0;
-            queue.push(0, state);
-        }
+static void compute_distances_general_cost(
+    const Graph &graph, int max_cost, const vector<int> &initial_states,
+    vector<int> &distances) {
+    if (max_cost <= MAX_COST_FOR_BUCKET_QUEUE) {
+        dial_search(graph, max_cost, initial_states, distances);
+    } else {
+        dijkstra_search(graph, initial_states, distances);
     }
-    dijkstra_search(backward_graph, queue, goal_distances);
 }
 
 void Distances::compute_distances(
@@ -229,25 +324,50 @@ void Distances::compute_distances(
         }
         utils::g_log << " distances using ";
     }
+    vector<int> init_states;
+    vector<int> goal_states;
+    if (compute_init_distances) {
+        init_states.push_back(transition_system.get_init_state());
+    }
+    if (compute_goal_distances) {
+        for (int state = 0; state < num_states; ++state) {
+            if (transition_system.is_goal_state(state)) {
+                goal_states.push_back(state);
+            }
+        }
+    }
     if (is_unit_cost()) {
         if (verbosity >= utils::Verbosity::VERBOSE) {
             utils::g_log << "unit-cost";
         }
+        /*
+          Breadth-first search needs the edges in both directions, so we
+          build both graphs once and use them for both computations.
+        */
+        Graph forward_graph = build_graph(transition_system, false, false);
+        Graph backward_graph = build_graph(transition_system, true, false);
         if (compute_init_distances) {
-            compute_init_distances_unit_cost();
+            breadth_first_search(
+                forward_graph, backward_graph, init_states, init_distances);
         }
         if (compute_goal_distances) {
-            compute_goal_distances_unit_cost();
+            breadth_first_search(
+                backward_graph, forward_graph, goal_states, goal_distances);
         }
     } else {
         if (verbosity >= utils::Verbosity::VERBOSE) {
             utils::g_log << "general-cost";
         }
+        int max_cost = get_max_label_cost();
         if (compute_init_distances) {
-            compute_init_distances_general_cost();
+            Graph forward_graph = build_graph(transition_system, false, true);
+            compute_distances_general_cost(
+                forward_graph, max_cost, init_states, init_distances);
         }
         if (compute_goal_distances) {
-            compute_goal_distances_general_cost();
+            Graph backward_graph = build_graph(transition_system, true, true);
+            compute_distances_general_cost(
+                backward_graph, max_cost, goal_states, goal_distances);
         }
     }
     if (verbosity >= utils::Verbosity::VERBOSE) {
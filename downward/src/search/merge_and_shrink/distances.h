@@ -32,11 +32,7 @@ class Distances {
     void clear_distances();
     int get_num_states() const;
     bool is_unit_cost() const;
-
-    void compute_init_distances_unit_cost();
-    void compute_goal_distances_unit_cost();
-    void compute_init_distances_general_cost();
-    void compute_goal_distances_general_cost();
+    int get_max_label_cost() const;
 public:
     explicit Distances(const TransitionSystem &transition_system);
     ~Distances() = default;
@@ -14,6 +14,7 @@
 
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/memory.h"
 #include "../utils/system.h"
 
 #include <cassert>
@@ -34,6 +35,9 @@ MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const options::Options &opts)
     utils::g_log << "Done initializing merge-and-shrink heuristic." << endl << endl;
 }
 
+MergeAndShrinkHeuristic::~MergeAndShrinkHeuristic() {
+}
+
 void MergeAndShrinkHeuristic::extract_factor(
     FactoredTransitionSystem &fts, int index) {
     /*
@@ -51,7 +55,9 @@ void MergeAndShrinkHeuristic::extract_factor(
     }
     assert(distances->are_goal_distances_computed());
     mas_representation->set_distances(*distances);
-    mas_representations.push_back(move(mas_representation));
+    mas_representations.push_back(
+        utils::make_unique_ptr<FlatMergeAndShrinkRepresentation>(
+            *mas_representation));
 }
 
 bool MergeAndShrinkHeuristic::extract_unsolvable_factor(FactoredTransitionSystem &fts) {
@@ -115,10 +121,12 @@ void MergeAndShrinkHeuristic::extract_factors(FactoredTransitionSystem &fts) {
 
 int MergeAndShrinkHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
     int heuristic = 0;
-    for (const unique_ptr<MergeAndShrinkRepresentation> &mas_representation : mas_representations) {
-        int cost = mas_representation->get_value(state);
-        if (cost == PRUNED_STATE || cost == INF) {
+    for (const unique_ptr<FlatMergeAndShrinkRepresentation> &mas_representation : mas_representations) {
+        int cost = mas_representation->get_value(values);
+        if (cost == INF) {
             // If state is unreachable or irrelevant, we encountered a dead end.
             return DEAD_END;
         }
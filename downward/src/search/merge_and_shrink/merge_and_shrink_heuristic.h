@@ -11,13 +11,13 @@ enum class Verbosity;
 
 namespace merge_and_shrink {
 class FactoredTransitionSystem;
-class MergeAndShrinkRepresentation;
+class FlatMergeAndShrinkRepresentation;
 
 class MergeAndShrinkHeuristic : public Heuristic {
     const utils::Verbosity verbosity;
 
     // The final merge-and-shrink representations, storing goal distances.
-    std::vector<std::unique_ptr<MergeAndShrinkRepresentation>> mas_representations;
+    std::vector<std::unique_ptr<FlatMergeAndShrinkRepresentation>> mas_representations;
 
     void extract_factor(FactoredTransitionSystem &fts, int index);
     bool extract_unsolvable_factor(FactoredTransitionSystem &fts);
@@ -27,6 +27,7 @@ protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     explicit MergeAndShrinkHeuristic(const options::Options &opts);
+    virtual ~MergeAndShrinkHeuristic() override;
 };
 }
 
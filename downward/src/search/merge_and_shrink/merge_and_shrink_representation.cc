@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <numeric>
 
 using namespace std;
@@ -79,6 +80,11 @@ void MergeAndShrinkRepresentationLeaf::dump() const {
     utils::g_log << endl;
 }
 
+int MergeAndShrinkRepresentationLeaf::flatten(
+    FlatMergeAndShrinkRepresentation &flat_representation) const {
+    return flat_representation.add_leaf(var_id, lookup_table);
+}
+
 
 MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
     unique_ptr<MergeAndShrinkRepresentation> left_child_,
@@ -157,4 +163,114 @@ void MergeAndShrinkRepresentationMerge::dump() const {
     utils::g_log << "right child:" << endl;
     right_child->dump();
 }
+
+int MergeAndShrinkRepresentationMerge::flatten(
+    FlatMergeAndShrinkRepresentation &flat_representation) const {
+    int left = left_child->flatten(flat_representation);
+    int right = right_child->flatten(flat_representation);
+    int stride = right_child->get_domain_size();
+    vector<int> table;
+    table.reserve(lookup_table.size() * stride);
+    for (const vector<int> &row : lookup_table) {
+        assert(static_cast<int>(row.size()) == stride);
+        table.insert(table.end(), row.begin(), row.end());
+    }
+    return flat_representation.add_merge(left, right, stride, table);
+}
+
+
+const int FlatMergeAndShrinkRepresentation::NO_CHILD;
+
+FlatMergeAndShrinkRepresentation::FlatMergeAndShrinkRepresentation(
+    const MergeAndShrinkRepresentation &representation) {
+    representation.flatten(*this);
+    values.resize(instructions.size());
+}
+
+template<typename Entry>
+static void append_entries(const vector<int> &table, vector<Entry> &entries) {
+    for (int value : table) {
+        if (value == PRUNED_STATE || value == INF) {
+            entries.push_back(numeric_limits<Entry>::max());
+        } else {
+            assert(value >= 0 && value < numeric_limits<Entry>::max());
+            entries.push_back(value);
+        }
+    }
+}
+
+int FlatMergeAndShrinkRepresentation::add_instruction(
+    int left, int right, int stride, const vector<int> &table) {
+    int max_value = 0;
+    for (int value : table) {
+        if (value != PRUNED_STATE && value != INF) {
+            max_value = max(max_value, value);
+        }
+    }
+    Instruction instruction;
+    instruction.left = left;
+    instruction.right = right;
+    instruction.stride = stride;
+    if (max_value < numeric_limits<uint8_t>::max()) {
+        instruction.entry_bits = 8;
+        instruction.table_offset = tables8.size();
+        append_entries(table, tables8);
+    } else if (max_value < numeric_limits<uint16_t>::max()) {
+        instruction.entry_bits = 16;
+        instruction.table_offset = tables16.size();
+        append_entries(table, tables16);
+    } else {
+        instruction.entry_bits = 32;
+        instruction.table_offset = tables32.size();
+        append_entries(table, tables32);
+    }
+    instructions.push_back(instruction);
+    return instructions.size() - 1;
+}
+
+int FlatMergeAndShrinkRepresentation::add_leaf(
+    int var_id, const vector<int> &table) {
+    return add_instruction(var_id, NO_CHILD, 0, table);
+}
+
+int FlatMergeAndShrinkRepresentation::add_merge(
+    int left, int right, int stride, const vector<int> &table) {
+    assert(left < static_cast<int>(instructions.size()) &&
+           right < static_cast<int>(instructions.size()));
+    return add_instruction(left, right, stride, table);
+}
+
+int FlatMergeAndShrinkRepresentation::get_value(const vector<int> &state) const {
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        const Instruction &instruction = instructions[i];
+        int index;
+        if (instruction.right == NO_CHILD) {
+            index = state[instruction.left];
+        } else {
+            index = values[instruction.left] * instruction.stride +
+                    values[instruction.right];
+        }
+        index += instruction.table_offset;
+
+        int value;
+        if (instruction.entry_bits == 8) {
+            uint8_t entry = tables8[index];
+            if (entry == numeric_limits<uint8_t>::max())
+                return INF;
+            value = entry;
+        } else if (instruction.entry_bits == 16) {
+            uint16_t entry = tables16[index];
+            if (entry == numeric_limits<uint16_t>::max())
+                return INF;
+            value = entry;
+        } else {
+            uint32_t entry = tables32[index];
+            if (entry == numeric_limits<uint32_t>::max())
+                return INF;
+            value = entry;
+        }
+        values[i] = value;
+    }
+    return values.back();
+}
 }
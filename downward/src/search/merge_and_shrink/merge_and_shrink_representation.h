@@ -1,6 +1,7 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -8,6 +9,8 @@ class State;
 
 namespace merge_and_shrink {
 class Distances;
+class FlatMergeAndShrinkRepresentation;
+
 class MergeAndShrinkRepresentation {
 protected:
     int domain_size;
@@ -33,6 +36,13 @@ public:
        to PRUNED_STATE. */
     virtual bool is_total() const = 0;
     virtual void dump() const = 0;
+    /*
+      Append the instructions computing the value of this representation
+      to the given flat representation and return the index of the
+      instruction that computes it.
+    */
+    virtual int flatten(
+        FlatMergeAndShrinkRepresentation &flat_representation) const = 0;
 };
 
 
@@ -50,6 +60,8 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump() const override;
+    virtual int flatten(
+        FlatMergeAndShrinkRepresentation &flat_representation) const override;
 };
 
 
@@ -69,6 +81,58 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump() const override;
+    virtual int flatten(
+        FlatMergeAndShrinkRepresentation &flat_representation) const override;
+};
+
+
+/*
+  Compiled form of a merge-and-shrink representation that has distances
+  set. The nodes of the tree become a sequence of instructions in
+  post-order, so that the values of the children of a node are known
+  when the node is evaluated. A leaf instruction looks up the value of
+  its variable in its table, a merge instruction looks up the entry
+  left_value * stride + right_value.
+
+  Depending on the largest entry, a table stores 8, 16 or 32 bits per
+  entry. The all-ones entry marks pruned states and, in the table of the
+  root, infinite distances. Evaluation stops as soon as it reaches such
+  an entry.
+*/
+class FlatMergeAndShrinkRepresentation {
+    static const int NO_CHILD = -1;
+
+    struct Instruction {
+        // Variable for leaves, instruction of the left child for merges.
+        int left;
+        // NO_CHILD for leaves, instruction of the right child for merges.
+        int right;
+        // Domain size of the right child.
+        int stride;
+        int table_offset;
+        // 8, 16 or 32
+        int entry_bits;
+    };
+
+    std::vector<Instruction> instructions;
+    std::vector<uint8_t> tables8;
+    std::vector<uint16_t> tables16;
+    std::vector<uint32_t> tables32;
+    // Value of each instruction for the state that is being evaluated.
+    mutable std::vector<int> values;
+
+    int add_instruction(int left, int right, int stride,
+                        const std::vector<int> &table);
+public:
+    explicit FlatMergeAndShrinkRepresentation(
+        const MergeAndShrinkRepresentation &representation);
+
+    int add_leaf(int var_id, const std::vector<int> &table);
+    int add_merge(int left, int right, int stride,
+                  const std::vector<int> &table);
+
+    // Return the goal distance of the given state or INF for dead ends.
+    int get_value(const std::vector<int> &state) const;
 };
 }
 
@@ -11,6 +11,8 @@
 #include "../utils/collections.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
 #include <algorithm>
@@ -34,69 +36,335 @@ namespace merge_and_shrink {
 using SuccessorSignature = vector<pair<int, int>>;
 
 /*
-  As we use SENTINEL numeric_limits<int>::max() as a sentinel signature and
-  irrelevant states have a distance of INF = numeric_limits<int>::max(), we
-  use INF - 1 as the distance value for all irrelevant states. This guarantees
-  that also irrelevant states are always ordered before the sentinel.
+  As irrelevant states have a distance of INF = numeric_limits<int>::max(),
+  we use INF - 1 as the distance value for all irrelevant states, so that
+  they are ordered after all other states.
 */
-const int SENTINEL = numeric_limits<int>::max();
-const int IRRELEVANT = SENTINEL - 1;
+const int IRRELEVANT = numeric_limits<int>::max() - 1;
 
 /*
-  The following class encodes all we need to know about a state for
-  bisimulation: its h value, which equivalence class ("group") it currently
-  belongs to, its successor signature (see above), and what the original
-  state is.
+  The signature of a state consists of its h value (-1 for goal states),
+  its current group, its successor signature (see above) and the state
+  itself. States are ordered by their signatures, and two states are not
+  distinguished in the current round iff they agree on everything but the
+  state.
+
+  Since states with different h values are never in the same group, we
+  keep the states in one block per h value and sort each block separately.
 */
+class SignatureRefinement {
+    const TransitionSystem &ts;
+    const Distances &distances;
+    const vector<int> &state_to_group;
+    const bool greedy;
+    const int num_threads;
 
-struct Signature {
-    int h_and_goal; // -1 for goal states; h value for non-goal states
-    int group;
-    SuccessorSignature succ_signature;
-    int state;
-
-    Signature(int h, bool is_goal, int group_,
-              const SuccessorSignature &succ_signature_,
-              int state_)
-        : group(group_), succ_signature(succ_signature_), state(state_) {
-        if (is_goal) {
+    /*
+      The relevant transitions (see for_each_transition) as pairs of
+      (label group ID, target), grouped by source state: the transitions
+      of state s are transitions[transitions_begin[s],
+      transitions_begin[s + 1]). The sources of the transitions into
+      state t are predecessors[predecessors_begin[t],
+      predecessors_begin[t + 1]).
+    */
+    vector<pair<int, int>> transitions;
+    vector<int> transitions_begin;
+    vector<int> predecessors;
+    vector<int> predecessors_begin;
+
+    vector<SuccessorSignature> succ_signatures;
+    /*
+      The states ordered by signature. Block b consists of
+      ordered_states[block_begin[b], block_begin[b + 1]).
+    */
+    vector<int> ordered_states;
+    vector<int> block_begin;
+    vector<int> state_to_block;
+
+    // States that changed their group since the last update.
+    vector<bool> group_changed;
+    vector<int> changed_states;
+    // States whose successor signature must be recomputed.
+    vector<bool> state_is_dirty;
+    vector<int> dirty_states;
+    // Blocks that must be sorted again.
+    vector<bool> block_is_dirty;
+
+    void compute_blocks();
+    template<typename Callback>
+    void for_each_transition(const Callback &callback) const;
+    void compute_transitions();
+    void compute_succ_signature(int state);
+    void mark_dirty(int state);
+public:
+    SignatureRefinement(
+        const TransitionSystem &ts, const Distances &distances,
+        const vector<int> &state_to_group, bool greedy, int num_threads);
+
+    /*
+      Recompute the successor signatures of all states with a successor
+      that changed its group and sort all blocks that contain a state
+      whose group or successor signature changed.
+    */
+    void update_signatures();
+
+    // Must be called for all states that changed their group.
+    void notify_group_changed(int state);
+
+    int get_num_blocks() const {
+        return block_begin.size() - 1;
+    }
+
+    int get_block_begin(int block) const {
+        return block_begin[block];
+    }
+
+    int get_block_end(int block) const {
+        return block_begin[block + 1];
+    }
+
+    int get_state(int index) const {
+        return ordered_states[index];
+    }
+
+    const SuccessorSignature &get_succ_signature(int state) const {
+        return succ_signatures[state];
+    }
+};
+
+SignatureRefinement::SignatureRefinement(
+    const TransitionSystem &ts, const Distances &distances,
+    const vector<int> &state_to_group, bool greedy, int num_threads)
+    : ts(ts),
+      distances(distances),
+      state_to_group(state_to_group),
+      greedy(greedy),
+      num_threads(num_threads) {
+    compute_blocks();
+    compute_transitions();
+    int num_states = ts.get_size();
+    succ_signatures.resize(num_states);
+    group_changed.assign(num_states, false);
+    state_is_dirty.assign(num_states, true);
+    dirty_states.reserve(num_states);
+    for (int state = 0; state < num_states; ++state) {
+        dirty_states.push_back(state);
+    }
+    block_is_dirty.assign(get_num_blocks(), true);
+}
+
+void SignatureRefinement::compute_blocks() {
+    int num_states = ts.get_size();
+    vector<int> h_and_goal(num_states);
+    for (int state = 0; state < num_states; ++state) {
+        int h = distances.get_goal_distance(state);
+        if (h == INF) {
+            h = IRRELEVANT;
+        }
+        if (ts.is_goal_state(state)) {
             assert(h == 0);
-            h_and_goal = -1;
-        } else {
-            h_and_goal = h;
+            h = -1;
         }
+        h_and_goal[state] = h;
     }
 
-    bool operator<(const Signature &other) const {
-        if (h_and_goal != other.h_and_goal)
-            return h_and_goal < other.h_and_goal;
-        if (group != other.group)
-            return group < other.group;
-        if (succ_signature != other.succ_signature)
-            return succ_signature < other.succ_signature;
-        return state < other.state;
+    vector<int> h_values = h_and_goal;
+    sort(h_values.begin(), h_values.end());
+    h_values.erase(unique(h_values.begin(), h_values.end()), h_values.end());
+    int num_blocks = h_values.size();
+
+    state_to_block.resize(num_states);
+    block_begin.assign(num_blocks + 1, 0);
+    for (int state = 0; state < num_states; ++state) {
+        int block = lower_bound(h_values.begin(), h_values.end(),
+                                h_and_goal[state]) - h_values.begin();
+        state_to_block[state] = block;
+        ++block_begin[block + 1];
     }
+    for (int block = 0; block < num_blocks; ++block) {
+        block_begin[block + 1] += block_begin[block];
+    }
+    ordered_states.resize(num_states);
+    vector<int> next_index(block_begin.begin(), block_begin.end() - 1);
+    for (int state = 0; state < num_states; ++state) {
+        ordered_states[next_index[state_to_block[state]]++] = state;
+    }
+}
 
-    void dump() const {
-        utils::g_log << "Signature(h_and_goal = " << h_and_goal
-                     << ", group = " << group
-                     << ", state = " << state
-                     << ", succ_sig = [";
-        for (size_t i = 0; i < succ_signature.size(); ++i) {
-            if (i)
-                utils::g_log << ", ";
-            utils::g_log << "(" << succ_signature[i].first
-                         << "," << succ_signature[i].second
-                         << ")";
+/*
+  Call callback(label_group_id, transition) for all transitions that are
+  relevant for the bisimulation.
+
+  Note that the final result of the bisimulation may depend on the
+  order in which transitions are considered below.
+
+  If label groups were sorted (every group by increasing label numbers,
+  groups by smallest label number), then the following configuration
+  gives a different result on parcprinter-08-strips:p06.pddl:
+  astar(merge_and_shrink(
+        merge_strategy=merge_stateless(merge_selector=
+            score_based_filtering(scoring_functions=[goal_relevance,dfp,
+                                                     total_order])),
+        shrink_strategy=shrink_bisimulation(greedy=false),
+        label_reduction=exact(before_shrinking=true,before_merging=false),
+        max_states=50000,threshold_before_merge=1))
+
+  The same behavioral difference can be obtained even without modifying
+  the merge-and-shrink code, using the two revisions c66ee00a250a and
+  d2e317621f2c. Running the above config, adapted to the old syntax,
+  yields the same difference:
+  astar(merge_and_shrink(merge_strategy=merge_dfp,
+        shrink_strategy=shrink_bisimulation(greedy=false,max_states=50000,
+                                            threshold=1),
+        label_reduction=exact(before_shrinking=true,before_merging=false)))
+*/
+template<typename Callback>
+void SignatureRefinement::for_each_transition(const Callback &callback) const {
+    int label_group_counter = 0;
+    for (GroupAndTransitions gat : ts) {
+        const LabelGroup &label_group = gat.label_group;
+        for (const Transition &transition : gat.transitions) {
+            bool skip_transition = false;
+            if (greedy) {
+                int src_h = distances.get_goal_distance(transition.src);
+                int target_h = distances.get_goal_distance(transition.target);
+                if (src_h == INF || target_h == INF) {
+                    // We skip transitions connected to an irrelevant state.
+                    skip_transition = true;
+                } else {
+                    int cost = label_group.get_cost();
+                    assert(target_h + cost >= src_h);
+                    skip_transition = (target_h + cost != src_h);
+                }
+            }
+            if (!skip_transition) {
+                callback(label_group_counter, transition);
+            }
         }
-        utils::g_log << "])" << endl;
+        ++label_group_counter;
     }
-};
+}
+
+void SignatureRefinement::compute_transitions() {
+    int num_states = ts.get_size();
+    transitions_begin.assign(num_states + 1, 0);
+    predecessors_begin.assign(num_states + 1, 0);
+    for_each_transition(
+        [&](int, const Transition &transition) {
+            ++transitions_begin[transition.src + 1];
+            ++predecessors_begin[transition.target + 1];
+        });
+    for (int state = 0; state < num_states; ++state) {
+        transitions_begin[state + 1] += transitions_begin[state];
+        predecessors_begin[state + 1] += predecessors_begin[state];
+    }
+
+    transitions.resize(transitions_begin[num_states]);
+    predecessors.resize(predecessors_begin[num_states]);
+    vector<int> next_transition(
+        transitions_begin.begin(), transitions_begin.end() - 1);
+    vector<int> next_predecessor(
+        predecessors_begin.begin(), predecessors_begin.end() - 1);
+    for_each_transition(
+        [&](int label_group_id, const Transition &transition) {
+            transitions[next_transition[transition.src]++] =
+                make_pair(label_group_id, transition.target);
+            predecessors[next_predecessor[transition.target]++] =
+                transition.src;
+        });
+}
+
+void SignatureRefinement::compute_succ_signature(int state) {
+    SuccessorSignature &succ_sig = succ_signatures[state];
+    succ_sig.clear();
+    for (int i = transitions_begin[state];
+         i < transitions_begin[state + 1]; ++i) {
+        int label_group_id = transitions[i].first;
+        int target_group = state_to_group[transitions[i].second];
+        assert(target_group != -1);
+        succ_sig.emplace_back(label_group_id, target_group);
+    }
+    sort(succ_sig.begin(), succ_sig.end());
+    succ_sig.erase(unique(succ_sig.begin(), succ_sig.end()), succ_sig.end());
+}
+
+void SignatureRefinement::update_signatures() {
+    // Mark the states with a successor that changed its group.
+    for (int state : changed_states) {
+        for (int i = predecessors_begin[state];
+             i < predecessors_begin[state + 1]; ++i) {
+            mark_dirty(predecessors[i]);
+        }
+        group_changed[state] = false;
+    }
+    changed_states.clear();
+
+    vector<int> dirty_blocks;
+    for (int block = 0; block < get_num_blocks(); ++block) {
+        if (block_is_dirty[block]) {
+            dirty_blocks.push_back(block);
+            block_is_dirty[block] = false;
+        }
+    }
+    /*
+      Every dirty state lies in a dirty block, and the blocks are disjoint,
+      so each thread recomputes the signatures of the dirty states in its
+      blocks and then sorts them. The order of the states is fully
+      determined by their signatures, so it does not depend on which
+      blocks are handled by which thread.
+    */
+    utils::parallel_for(
+        dirty_blocks.size(), num_threads,
+        [&](int i, int) {
+            int block = dirty_blocks[i];
+            for (int index = block_begin[block];
+                 index < block_begin[block + 1]; ++index) {
+                int state = ordered_states[index];
+                if (state_is_dirty[state]) {
+                    compute_succ_signature(state);
+                }
+            }
+            sort(ordered_states.begin() + block_begin[block],
+                 ordered_states.begin() + block_begin[block + 1],
+                 [&](int state1, int state2) {
+                     int group1 = state_to_group[state1];
+                     int group2 = state_to_group[state2];
+                     if (group1 != group2)
+                         return group1 < group2;
+                     const SuccessorSignature &succ_sig1 = succ_signatures[state1];
+                     const SuccessorSignature &succ_sig2 = succ_signatures[state2];
+                     if (succ_sig1 != succ_sig2)
+                         return succ_sig1 < succ_sig2;
+                     return state1 < state2;
+                 });
+        });
+    for (int state : dirty_states) {
+        state_is_dirty[state] = false;
+    }
+    dirty_states.clear();
+}
+
+void SignatureRefinement::mark_dirty(int state) {
+    if (!state_is_dirty[state]) {
+        state_is_dirty[state] = true;
+        dirty_states.push_back(state);
+    }
+    block_is_dirty[state_to_block[state]] = true;
+}
+
+void SignatureRefinement::notify_group_changed(int state) {
+    if (!group_changed[state]) {
+        group_changed[state] = true;
+        changed_states.push_back(state);
+    }
+    block_is_dirty[state_to_block[state]] = true;
+}
 
 
 ShrinkBisimulation::ShrinkBisimulation(const Options &opts)
     : greedy(opts.get<bool>("greedy")),
-      at_limit(opts.get<AtLimit>("at_limit")) {
+      at_limit(opts.get<AtLimit>("at_limit")),
+      num_threads(opts.get<int>("threads")) {
 }
 
 int ShrinkBisimulation::initialize_groups(
@@ -137,106 +405,6 @@ int ShrinkBisimulation::initialize_groups(
     return num_groups;
 }
 
-void ShrinkBisimulation::compute_signatures(
-    const TransitionSystem &ts,
-    const Distances &distances,
-    vector<Signature> &signatures,
-    const vector<int> &state_to_group) const {
-    assert(signatures.empty());
-
-    // Step 1: Compute bare state signatures (without transition information).
-    signatures.push_back(Signature(-2, false, -1, SuccessorSignature(), -1));
-    for (int state = 0; state < ts.get_size(); ++state) {
-        int h = distances.get_goal_distance(state);
-        if (h == INF) {
-            h = IRRELEVANT;
-        }
-        Signature signature(h, ts.is_goal_state(state),
-                            state_to_group[state], SuccessorSignature(),
-                            state);
-        signatures.push_back(signature);
-    }
-    signatures.push_back(Signature(SENTINEL, false, -1, SuccessorSignature(), -1));
-
-    // Step 2: Add transition information.
-    int label_group_counter = 0;
-    /*
-      Note that the final result of the bisimulation may depend on the
-      order in which transitions are considered below.
-
-      If label groups were sorted (every group by increasing label numbers,
-      groups by smallest label number), then the following configuration
-      gives a different result on parcprinter-08-strips:p06.pddl:
-      astar(merge_and_shrink(
-            merge_strategy=merge_stateless(merge_selector=
-                score_based_filtering(scoring_functions=[goal_relevance,dfp,
-                                                         total_order])),
-            shrink_strategy=shrink_bisimulation(greedy=false),
-            label_reduction=exact(before_shrinking=true,before_merging=false),
-            max_states=50000,threshold_before_merge=1))
-
-      The same behavioral difference can be obtained even without modifying
-      the merge-and-shrink code, using the two revisions c66ee00a250a and
-      d2e317621f2c. Running the above config, adapted to the old syntax,
-      yields the same difference:
-      astar(merge_and_shrink(merge_strategy=merge_dfp,
-            shrink_strategy=shrink_bisimulation(greedy=false,max_states=50000,
-                                                threshold=1),
-            label_reduction=exact(before_shrinking=true,before_merging=false)))
-    */
-    for (GroupAndTransitions gat : ts) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            assert(signatures[transition.src + 1].state == transition.src);
-            bool skip_transition = false;
-            if (greedy) {
-                int src_h = distances.get_goal_distance(transition.src);
-                int target_h = distances.get_goal_distance(transition.target);
-                if (src_h == INF || target_h == INF) {
-                    // We skip transitions connected to an irrelevant state.
-                    skip_transition = true;
-                } else {
-                    int cost = label_group.get_cost();
-                    assert(target_h + cost >= src_h);
-                    skip_transition = (target_h + cost != src_h);
-                }
-            }
-            if (!skip_transition) {
-                int target_group = state_to_group[transition.target];
-                assert(target_group != -1 && target_group != SENTINEL);
-                signatures[transition.src + 1].succ_signature.push_back(
-                    make_pair(label_group_counter, target_group));
-            }
-        }
-        ++label_group_counter;
-    }
-
-    /* Step 3: Canonicalize the representation. The resulting
-       signatures must satisfy the following properties:
-
-       1. Signature::operator< defines a total order with the correct
-          sentinels at the start and end. The signatures vector is
-          sorted according to that order.
-       2. Goal states come before non-goal states, and low-h states come
-          before high-h states.
-       3. States that currently fall into the same group form contiguous
-          subsequences.
-       4. Two signatures compare equal according to Signature::operator<
-          iff we don't want to distinguish their states in the current
-          bisimulation round.
-     */
-
-    for (size_t i = 0; i < signatures.size(); ++i) {
-        SuccessorSignature &succ_sig = signatures[i].succ_signature;
-        ::sort(succ_sig.begin(), succ_sig.end());
-        succ_sig.erase(::unique(succ_sig.begin(), succ_sig.end()),
-                       succ_sig.end());
-    }
-
-    ::sort(signatures.begin(), signatures.end());
-}
-
 StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
     const TransitionSystem &ts,
     const Distances &distances,
@@ -245,8 +413,6 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
     int num_states = ts.get_size();
 
     vector<int> state_to_group(num_states);
-    vector<Signature> signatures;
-    signatures.reserve(num_states + 2);
 
     int num_groups = initialize_groups(ts, distances, state_to_group);
     // utils::g_log << "number of initial groups: " << num_groups << endl;
@@ -254,52 +420,50 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
     // TODO: We currently violate this; see issue250
     // assert(num_groups <= target_size);
 
+    /*
+      In every round, the states are ordered by their signatures (see
+      SignatureRefinement) and every group is split into the subgroups of
+      states with equal signatures. Only states with a successor that
+      changed its group get a new signature in the next round, and only
+      blocks with changed states are sorted again.
+    */
+    unique_ptr<SignatureRefinement> refinement;
+    if (num_groups < target_size) {
+        refinement = utils::make_unique_ptr<SignatureRefinement>(
+            ts, distances, state_to_group, greedy, num_threads);
+    }
+
     bool stable = false;
     bool stop_requested = false;
     while (!stable && !stop_requested && num_groups < target_size) {
         stable = true;
 
-        signatures.clear();
-        compute_signatures(ts, distances, signatures, state_to_group);
-
-        // Verify size of signatures and presence of sentinels.
-        assert(static_cast<int>(signatures.size()) == num_states + 2);
-        assert(signatures[0].h_and_goal == -2);
-        assert(signatures[num_states + 1].h_and_goal == SENTINEL);
+        refinement->update_signatures();
 
-        int sig_start = 1; // Skip over initial sentinel.
-        while (true) {
-            int h_and_goal = signatures[sig_start].h_and_goal;
-            if (h_and_goal == SENTINEL) {
-                // We have hit the end sentinel.
-                assert(sig_start + 1 == static_cast<int>(signatures.size()));
-                break;
-            }
+        for (int block = 0; block < refinement->get_num_blocks(); ++block) {
+            int block_begin = refinement->get_block_begin(block);
+            int block_end = refinement->get_block_end(block);
 
             // Compute the number of groups needed after splitting.
             int num_old_groups = 0;
             int num_new_groups = 0;
-            int sig_end;
-            for (sig_end = sig_start; true; ++sig_end) {
-                if (signatures[sig_end].h_and_goal != h_and_goal) {
-                    break;
-                }
-
-                const Signature &prev_sig = signatures[sig_end - 1];
-                const Signature &curr_sig = signatures[sig_end];
-
-                if (sig_end == sig_start) {
-                    assert(prev_sig.group != curr_sig.group);
+            for (int i = block_begin; i < block_end; ++i) {
+                int curr_state = refinement->get_state(i);
+                if (i == block_begin) {
+                    ++num_old_groups;
+                    ++num_new_groups;
+                    continue;
                 }
-
-                if (prev_sig.group != curr_sig.group) {
+                int prev_state = refinement->get_state(i - 1);
+                if (state_to_group[prev_state] != state_to_group[curr_state]) {
                     ++num_old_groups;
                     ++num_new_groups;
-                } else if (prev_sig.succ_signature != curr_sig.succ_signature) {
+                } else if (refinement->get_succ_signature(prev_state) !=
+                           refinement->get_succ_signature(curr_state)) {
                     ++num_new_groups;
                 }
             }
-            assert(sig_end > sig_start);
+            assert(block_end > block_begin);
 
             if (at_limit == AtLimit::RETURN &&
                 num_groups - num_old_groups + num_new_groups > target_size) {
@@ -314,35 +478,41 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
                 stable = false;
 
                 int new_group_no = -1;
-                for (int i = sig_start; i < sig_end; ++i) {
-                    const Signature &prev_sig = signatures[i - 1];
-                    const Signature &curr_sig = signatures[i];
+                // Group of the previous state before splitting.
+                int prev_group = -1;
+                for (int i = block_begin; i < block_end; ++i) {
+                    int curr_state = refinement->get_state(i);
+                    int curr_group = state_to_group[curr_state];
 
-                    if (prev_sig.group != curr_sig.group) {
+                    if (i == block_begin || prev_group != curr_group) {
                         // Start first group of a block; keep old group no.
-                        new_group_no = curr_sig.group;
-                    } else if (prev_sig.succ_signature
-                               != curr_sig.succ_signature) {
+                        new_group_no = curr_group;
+                    } else if (refinement->get_succ_signature(
+                                   refinement->get_state(i - 1)) !=
+                               refinement->get_succ_signature(curr_state)) {
                         new_group_no = num_groups++;
                         assert(num_groups <= target_size);
                     }
+                    prev_group = curr_group;
 
                     assert(new_group_no != -1);
-                    state_to_group[curr_sig.state] = new_group_no;
+                    if (new_group_no != curr_group) {
+                        state_to_group[curr_state] = new_group_no;
+                        refinement->notify_group_changed(curr_state);
+                    }
                     if (num_groups == target_size)
                         break;
                 }
                 if (num_groups == target_size)
                     break;
             }
-            sig_start = sig_end;
         }
     }
 
     /* Reduce memory pressure before generating the equivalence
        relation since this is one of the code parts relevant to peak
        memory. */
-    utils::release_vector_memory(signatures);
+    refinement = nullptr;
 
     // Generate final result.
     StateEquivalenceRelation equivalence_relation;
@@ -419,6 +589,10 @@ static shared_ptr<ShrinkStrategy>_parse(OptionParser &parser) {
     parser.add_enum_option<AtLimit>(
         "at_limit", at_limit,
         "what to do when the size limit is hit", "RETURN");
+    utils::add_threads_option_to_parser(
+        parser,
+        "number of threads for computing and sorting signatures (the "
+        "resulting abstraction does not depend on this number)");
 
     Options opts = parser.parse();
 
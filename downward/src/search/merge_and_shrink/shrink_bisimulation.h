@@ -8,8 +8,6 @@ class Options;
 }
 
 namespace merge_and_shrink {
-struct Signature;
-
 enum class AtLimit {
     RETURN,
     USE_UP
@@ -18,6 +16,8 @@ enum class AtLimit {
 class ShrinkBisimulation : public ShrinkStrategy {
     const bool greedy;
     const AtLimit at_limit;
+    // number of threads for computing and sorting signatures
+    const int num_threads;
 
     void compute_abstraction(
         const TransitionSystem &ts,
@@ -29,12 +29,6 @@ class ShrinkBisimulation : public ShrinkStrategy {
         const TransitionSystem &ts,
         const Distances &distances,
         std::vector<int> &state_to_group) const;
-
-    void compute_signatures(
-        const TransitionSystem &ts,
-        const Distances &distances,
-        std::vector<Signature> &signatures,
-        const std::vector<int> &state_to_group) const;
 protected:
     virtual void dump_strategy_specific_options() const override;
     virtual std::string name() const override;
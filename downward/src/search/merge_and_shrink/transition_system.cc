@@ -28,18 +28,14 @@ ostream &operator<<(ostream &os, const Transition &trans) {
     return os;
 }
 
-// Sorts the given set of transitions and removes duplicates.
-static void normalize_given_transitions(vector<Transition> &transitions) {
-    sort(transitions.begin(), transitions.end());
-    transitions.erase(unique(transitions.begin(), transitions.end()), transitions.end());
-}
-
 TSConstIterator::TSConstIterator(
     const LabelEquivalenceRelation &label_equivalence_relation,
-    const vector<vector<Transition>> &transitions_by_group_id,
+    const vector<Transition> &transitions,
+    const vector<size_t> &group_offsets,
     bool end)
     : label_equivalence_relation(label_equivalence_relation),
-      transitions_by_group_id(transitions_by_group_id),
+      transitions(transitions),
+      group_offsets(group_offsets),
       current_group_id((end ? label_equivalence_relation.get_size() : 0)) {
     next_valid_index();
 }
@@ -57,9 +53,11 @@ void TSConstIterator::operator++() {
 }
 
 GroupAndTransitions TSConstIterator::operator*() const {
+    const Transition *group_transitions = transitions.data();
     return GroupAndTransitions(
         label_equivalence_relation.get_group(current_group_id),
-        transitions_by_group_id[current_group_id]);
+        TransitionRange(group_transitions + group_offsets[current_group_id],
+                        group_transitions + group_offsets[current_group_id + 1]));
 }
 
 
@@ -76,6 +74,12 @@ GroupAndTransitions TSConstIterator::operator*() const {
   transitions itself. Various experiments have shown that maintaining
   a graph representation permanently for the benefit of distance
   computation is not worth the overhead.
+
+  All transitions live in a single buffer. Products are written into a
+  buffer of the exact final size, and abstractions and label reductions
+  rewrite the buffer in place, so that at no point we need to store a
+  second copy of all transitions (apart from reallocating the buffer when
+  releasing unused memory).
 */
 
 TransitionSystem::TransitionSystem(
@@ -89,7 +93,40 @@ TransitionSystem::TransitionSystem(
     : num_variables(num_variables),
       incorporated_variables(move(incorporated_variables)),
       label_equivalence_relation(move(label_equivalence_relation)),
-      transitions_by_group_id(move(transitions_by_group_id)),
+      num_states(num_states),
+      goal_states(move(goal_states)),
+      init_state(init_state) {
+    size_t num_transitions = 0;
+    for (const vector<Transition> &group_transitions : transitions_by_group_id) {
+        num_transitions += group_transitions.size();
+    }
+    transitions.reserve(num_transitions);
+    group_offsets.reserve(transitions_by_group_id.size() + 1);
+    group_offsets.push_back(0);
+    for (vector<Transition> &group_transitions : transitions_by_group_id) {
+        transitions.insert(transitions.end(), group_transitions.begin(),
+                           group_transitions.end());
+        utils::release_vector_memory(group_transitions);
+        group_offsets.push_back(transitions.size());
+    }
+    assert(are_transitions_sorted_unique());
+    assert(in_sync_with_label_equivalence_relation());
+}
+
+TransitionSystem::TransitionSystem(
+    int num_variables,
+    vector<int> &&incorporated_variables,
+    unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
+    vector<Transition> &&transitions,
+    vector<size_t> &&group_offsets,
+    int num_states,
+    vector<bool> &&goal_states,
+    int init_state)
+    : num_variables(num_variables),
+      incorporated_variables(move(incorporated_variables)),
+      label_equivalence_relation(move(label_equivalence_relation)),
+      transitions(move(transitions)),
+      group_offsets(move(group_offsets)),
       num_states(num_states),
       goal_states(move(goal_states)),
       init_state(init_state) {
@@ -103,7 +140,8 @@ TransitionSystem::TransitionSystem(const TransitionSystem &other)
       label_equivalence_relation(
           utils::make_unique_ptr<LabelEquivalenceRelation>(
               *other.label_equivalence_relation)),
-      transitions_by_group_id(other.transitions_by_group_id),
+      transitions(other.transitions),
+      group_offsets(other.group_offsets),
       num_states(other.num_states),
       goal_states(other.goal_states),
       init_state(other.init_state) {
@@ -132,8 +170,6 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         ts2.incorporated_variables.begin(), ts2.incorporated_variables.end(),
         back_inserter(incorporated_variables));
     vector<vector<int>> label_groups;
-    vector<vector<Transition>> transitions_by_group_id;
-    transitions_by_group_id.reserve(labels.get_max_size());
 
     int ts1_size = ts1.get_size();
     int ts2_size = ts2.get_size();
@@ -160,58 +196,79 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
       (B) they are both dead in T (e.g., this includes the case where
           l is dead in T1 only and l' is dead in T2 only, so they are not
           locally equivalent in either of the components).
+
+      In a first pass, we compute the label groups of the product together
+      with the pairs of component groups they stem from. This tells us the
+      exact number of transitions of the product, so that the second pass
+      can write them into a single buffer without reallocating it.
     */
-    int multiplier = ts2_size;
+    const LabelEquivalenceRelation &relation1 = *ts1.label_equivalence_relation;
+    const LabelEquivalenceRelation &relation2 = *ts2.label_equivalence_relation;
+    vector<pair<int, int>> component_group_ids;
+    vector<Transition> transitions;
+    size_t num_transitions = 0;
     vector<int> dead_labels;
-    for (GroupAndTransitions gat : ts1) {
-        const LabelGroup &group1 = gat.label_group;
-        const vector<Transition> &transitions1 = gat.transitions;
+    for (int group1_id = 0; group1_id < relation1.get_size(); ++group1_id) {
+        if (relation1.is_empty_group(group1_id)) {
+            continue;
+        }
+        const LabelGroup &group1 = relation1.get_group(group1_id);
+        size_t num_transitions1 = ts1.get_transitions_for_group_id(group1_id).size();
 
         // Distribute the labels of this group among the "buckets"
         // corresponding to the groups of ts2.
         unordered_map<int, vector<int>> buckets;
         for (int label_no : group1) {
-            int group2_id = ts2.label_equivalence_relation->get_group_id(label_no);
+            int group2_id = relation2.get_group_id(label_no);
             buckets[group2_id].push_back(label_no);
         }
         // Now buckets contains all equivalence classes that are
         // refinements of group1.
 
-        // Now create the new groups together with their transitions.
+        // Now create the new groups.
         for (auto &bucket : buckets) {
-            const vector<Transition> &transitions2 =
-                ts2.get_transitions_for_group_id(bucket.first);
-
-            // Create the new transitions for this bucket
-            vector<Transition> new_transitions;
-            if (!transitions1.empty() && !transitions2.empty()
-                && transitions1.size() > new_transitions.max_size() / transitions2.size())
-                utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
-            new_transitions.reserve(transitions1.size() * transitions2.size());
-            for (const Transition &transition1 : transitions1) {
-                int src1 = transition1.src;
-                int target1 = transition1.target;
-                for (const Transition &transition2 : transitions2) {
-                    int src2 = transition2.src;
-                    int target2 = transition2.target;
-                    int src = src1 * multiplier + src2;
-                    int target = target1 * multiplier + target2;
-                    new_transitions.push_back(Transition(src, target));
-                }
-            }
-
-            // Create a new group if the transitions are not empty
+            size_t num_transitions2 =
+                ts2.get_transitions_for_group_id(bucket.first).size();
             vector<int> &new_labels = bucket.second;
-            if (new_transitions.empty()) {
+            if (num_transitions1 == 0 || num_transitions2 == 0) {
                 dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
             } else {
-                sort(new_transitions.begin(), new_transitions.end());
+                if (num_transitions1 >
+                    (transitions.max_size() - num_transitions) / num_transitions2)
+                    utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+                num_transitions += num_transitions1 * num_transitions2;
                 label_groups.push_back(move(new_labels));
-                transitions_by_group_id.push_back(move(new_transitions));
+                component_group_ids.emplace_back(group1_id, bucket.first);
             }
         }
     }
 
+    // Create the transitions of the new groups.
+    int multiplier = ts2_size;
+    transitions.reserve(num_transitions);
+    vector<size_t> group_offsets;
+    group_offsets.reserve(label_groups.size() + 2);
+    group_offsets.push_back(0);
+    for (const pair<int, int> &group_ids : component_group_ids) {
+        TransitionRange transitions1 = ts1.get_transitions_for_group_id(group_ids.first);
+        TransitionRange transitions2 = ts2.get_transitions_for_group_id(group_ids.second);
+        size_t group_begin = transitions.size();
+        for (const Transition &transition1 : transitions1) {
+            int src1 = transition1.src;
+            int target1 = transition1.target;
+            for (const Transition &transition2 : transitions2) {
+                int src2 = transition2.src;
+                int target2 = transition2.target;
+                int src = src1 * multiplier + src2;
+                int target = target1 * multiplier + target2;
+                transitions.push_back(Transition(src, target));
+            }
+        }
+        sort(transitions.begin() + group_begin, transitions.end());
+        group_offsets.push_back(transitions.size());
+    }
+    assert(transitions.size() == num_transitions);
+
     /*
       We collect all dead labels separately, because the bucket refining
       does not work in cases where there are at least two dead labels l1
@@ -222,10 +279,10 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     if (!dead_labels.empty()) {
         label_groups.push_back(move(dead_labels));
         // Dead labels have empty transitions
-        transitions_by_group_id.emplace_back();
+        group_offsets.push_back(transitions.size());
     }
 
-    assert(transitions_by_group_id.size() == label_groups.size());
+    assert(group_offsets.size() == label_groups.size() + 1);
 
     unique_ptr<LabelEquivalenceRelation> label_equivalence_relation =
         utils::make_unique_ptr<LabelEquivalenceRelation>(labels, label_groups);
@@ -234,7 +291,8 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         num_variables,
         move(incorporated_variables),
         move(label_equivalence_relation),
-        move(transitions_by_group_id),
+        move(transitions),
+        move(group_offsets),
         num_states,
         move(goal_states),
         init_state
@@ -249,20 +307,51 @@ void TransitionSystem::compute_locally_equivalent_labels() {
     for (int group_id1 = 0; group_id1 < label_equivalence_relation->get_size();
          ++group_id1) {
         if (!label_equivalence_relation->is_empty_group(group_id1)) {
-            const vector<Transition> &transitions1 = transitions_by_group_id[group_id1];
+            TransitionRange transitions1 = get_transitions_for_group_id(group_id1);
             for (int group_id2 = group_id1 + 1;
                  group_id2 < label_equivalence_relation->get_size(); ++group_id2) {
                 if (!label_equivalence_relation->is_empty_group(group_id2)) {
-                    vector<Transition> &transitions2 = transitions_by_group_id[group_id2];
-                    if (transitions1 == transitions2) {
+                    TransitionRange transitions2 = get_transitions_for_group_id(group_id2);
+                    if (transitions1.size() == transitions2.size() &&
+                        equal(transitions1.begin(), transitions1.end(),
+                              transitions2.begin())) {
                         label_equivalence_relation->move_group_into_group(
                             group_id2, group_id1);
-                        utils::release_vector_memory(transitions2);
                     }
                 }
             }
         }
     }
+    compact_transitions();
+}
+
+void TransitionSystem::compact_transitions() {
+    assert(in_sync_with_label_equivalence_relation());
+    size_t num_transitions = 0;
+    for (int group_id = 0; group_id < label_equivalence_relation->get_size();
+         ++group_id) {
+        size_t group_begin = group_offsets[group_id];
+        size_t group_end = group_offsets[group_id + 1];
+        group_offsets[group_id] = num_transitions;
+        if (!label_equivalence_relation->is_empty_group(group_id)) {
+            // Transitions only move to the front, so this cannot overwrite
+            // transitions that still have to be moved.
+            assert(num_transitions <= group_begin);
+            copy(transitions.begin() + group_begin,
+                 transitions.begin() + group_end,
+                 transitions.begin() + num_transitions);
+            num_transitions += group_end - group_begin;
+        }
+    }
+    group_offsets.back() = num_transitions;
+    transitions.erase(transitions.begin() + num_transitions, transitions.end());
+    /*
+      Releasing unused capacity copies the whole buffer, so we only do it
+      if at least half of the capacity is unused.
+    */
+    if (transitions.capacity() > 2 * transitions.size()) {
+        transitions.shrink_to_fit();
+    }
 }
 
 void TransitionSystem::apply_abstraction(
@@ -294,32 +383,36 @@ void TransitionSystem::apply_abstraction(
     }
     goal_states = move(new_goal_states);
 
-    // Update all transitions.
-    for (vector<Transition> &transitions : transitions_by_group_id) {
-        if (!transitions.empty()) {
-            vector<Transition> new_transitions;
-            /*
-              We reserve more memory than necessary here, but this is better
-              than potentially resizing the vector several times when inserting
-              transitions one after the other. See issue604-v6.
-
-              An alternative could be to not use a new vector, but to modify
-              the existing transitions inplace, and to remove all empty
-              positions in the end. This would be more ugly, though.
-            */
-            new_transitions.reserve(transitions.size());
-            for (size_t i = 0; i < transitions.size(); ++i) {
-                const Transition &transition = transitions[i];
-                int src = abstraction_mapping[transition.src];
-                int target = abstraction_mapping[transition.target];
-                if (src != PRUNED_STATE && target != PRUNED_STATE)
-                    new_transitions.push_back(Transition(src, target));
-            }
-            normalize_given_transitions(new_transitions);
-            transitions = move(new_transitions);
+    /*
+      Update all transitions in place. The new transitions of a group never
+      need more space than its old transitions, so we can write them to the
+      front of the buffer while reading the old transitions.
+    */
+    size_t num_transitions = 0;
+    for (int group_id = 0; group_id < label_equivalence_relation->get_size();
+         ++group_id) {
+        size_t group_begin = group_offsets[group_id];
+        size_t group_end = group_offsets[group_id + 1];
+        size_t new_group_begin = num_transitions;
+        group_offsets[group_id] = new_group_begin;
+        for (size_t i = group_begin; i < group_end; ++i) {
+            const Transition &transition = transitions[i];
+            int src = abstraction_mapping[transition.src];
+            int target = abstraction_mapping[transition.target];
+            if (src != PRUNED_STATE && target != PRUNED_STATE)
+                transitions[num_transitions++] = Transition(src, target);
         }
+        // Sort the new transitions of the group and remove duplicates.
+        auto new_group_transitions_begin = transitions.begin() + new_group_begin;
+        auto new_group_transitions_end = transitions.begin() + num_transitions;
+        sort(new_group_transitions_begin, new_group_transitions_end);
+        num_transitions = unique(new_group_transitions_begin,
+                                 new_group_transitions_end) - transitions.begin();
     }
+    group_offsets.back() = num_transitions;
+    transitions.erase(transitions.begin() + num_transitions, transitions.end());
 
+    // This also releases the memory that is no longer needed.
     compute_locally_equivalent_labels();
 
     num_states = new_num_states;
@@ -384,8 +477,10 @@ void TransitionSystem::apply_label_reduction(
                 int group_id = label_equivalence_relation->get_group_id(old_label_no);
                 if (seen_group_ids.insert(group_id).second) {
                     affected_group_ids.insert(group_id);
-                    const vector<Transition> &transitions = transitions_by_group_id[group_id];
-                    new_label_transitions.insert(transitions.begin(), transitions.end());
+                    TransitionRange group_transitions =
+                        get_transitions_for_group_id(group_id);
+                    new_label_transitions.insert(group_transitions.begin(),
+                                                 group_transitions.end());
                 }
             }
             new_transitions.emplace_back(
@@ -407,24 +502,29 @@ void TransitionSystem::apply_label_reduction(
           position.
 
           NOTE: it is important that this happens in increasing order of label
-          numbers to ensure that transitions_by_group_id are synchronized with
+          numbers to ensure that group_offsets are synchronized with the
           label groups of label_equivalence_relation.
         */
+        size_t num_new_transitions = 0;
+        for (const vector<Transition> &label_transitions : new_transitions) {
+            num_new_transitions += label_transitions.size();
+        }
+        transitions.reserve(transitions.size() + num_new_transitions);
         for (size_t i = 0; i < label_mapping.size(); ++i) {
-            vector<Transition> &transitions = new_transitions[i];
+            vector<Transition> &label_transitions = new_transitions[i];
             assert(label_equivalence_relation->get_group_id(label_mapping[i].first)
-                   == static_cast<int>(transitions_by_group_id.size()));
-            transitions_by_group_id.push_back(move(transitions));
-        }
-
-        // Go over all affected group IDs and remove their transitions if the
-        // group is empty.
-        for (int group_id : affected_group_ids) {
-            if (label_equivalence_relation->is_empty_group(group_id)) {
-                utils::release_vector_memory(transitions_by_group_id[group_id]);
-            }
+                   == static_cast<int>(group_offsets.size()) - 1);
+            transitions.insert(transitions.end(), label_transitions.begin(),
+                               label_transitions.end());
+            utils::release_vector_memory(label_transitions);
+            group_offsets.push_back(transitions.size());
         }
 
+        /*
+          The transitions of affected groups that became empty are removed
+          when compacting the buffer after computing locally equivalent
+          labels.
+        */
         compute_locally_equivalent_labels();
     }
 
@@ -440,15 +540,18 @@ string TransitionSystem::tag() const {
 
 bool TransitionSystem::are_transitions_sorted_unique() const {
     for (GroupAndTransitions gat : *this) {
-        if (!utils::is_sorted_unique(gat.transitions))
-            return false;
+        const TransitionRange &group_transitions = gat.transitions;
+        for (size_t i = 1; i < group_transitions.size(); ++i) {
+            if (group_transitions[i - 1] >= group_transitions[i])
+                return false;
+        }
     }
     return true;
 }
 
 bool TransitionSystem::in_sync_with_label_equivalence_relation() const {
-    return label_equivalence_relation->get_size() ==
-           static_cast<int>(transitions_by_group_id.size());
+    return label_equivalence_relation->get_size() + 1 ==
+           static_cast<int>(group_offsets.size());
 }
 
 bool TransitionSystem::is_solvable(const Distances &distances) const {
@@ -462,11 +565,7 @@ bool TransitionSystem::is_solvable(const Distances &distances) const {
 }
 
 int TransitionSystem::compute_total_transitions() const {
-    int total = 0;
-    for (GroupAndTransitions gat : *this) {
-        total += gat.transitions.size();
-    }
-    return total;
+    return transitions.size();
 }
 
 string TransitionSystem::get_description() const {
@@ -497,8 +596,7 @@ void TransitionSystem::dump_dot_graph() const {
     }
     for (GroupAndTransitions gat : *this) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
+        for (const Transition &transition : gat.transitions) {
             int src = transition.src;
             int target = transition.target;
             utils::g_log << "    node" << src << " -> node" << target << " [label = ";
@@ -528,10 +626,10 @@ void TransitionSystem::dump_labels_and_transitions() const {
         }
         utils::g_log << endl;
         utils::g_log << "transitions: ";
-        const vector<Transition> &transitions = gat.transitions;
-        for (size_t i = 0; i < transitions.size(); ++i) {
-            int src = transitions[i].src;
-            int target = transitions[i].target;
+        const TransitionRange &group_transitions = gat.transitions;
+        for (size_t i = 0; i < group_transitions.size(); ++i) {
+            int src = group_transitions[i].src;
+            int target = group_transitions[i].target;
             if (i != 0)
                 utils::g_log << ",";
             utils::g_log << src << " -> " << target;
@@ -3,6 +3,7 @@
 
 #include "types.h"
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -41,11 +42,45 @@ struct Transition {
     }
 };
 
+/*
+  The transitions of a label group, i.e., a contiguous range of the
+  transition buffer of a TransitionSystem. The range is invalidated by
+  all modifications of the transition system.
+*/
+class TransitionRange {
+    const Transition *first;
+    const Transition *last;
+public:
+    TransitionRange(const Transition *first, const Transition *last)
+        : first(first), last(last) {
+    }
+
+    const Transition *begin() const {
+        return first;
+    }
+
+    const Transition *end() const {
+        return last;
+    }
+
+    std::size_t size() const {
+        return last - first;
+    }
+
+    bool empty() const {
+        return first == last;
+    }
+
+    const Transition &operator[](std::size_t index) const {
+        return first[index];
+    }
+};
+
 struct GroupAndTransitions {
     const LabelGroup &label_group;
-    const std::vector<Transition> &transitions;
+    const TransitionRange transitions;
     GroupAndTransitions(const LabelGroup &label_group,
-                        const std::vector<Transition> &transitions)
+                        const TransitionRange &transitions)
         : label_group(label_group),
           transitions(transitions) {
     }
@@ -59,14 +94,16 @@ class TSConstIterator {
       easily exchanged.
     */
     const LabelEquivalenceRelation &label_equivalence_relation;
-    const std::vector<std::vector<Transition>> &transitions_by_group_id;
+    const std::vector<Transition> &transitions;
+    const std::vector<std::size_t> &group_offsets;
     // current_group_id is the actual iterator
     int current_group_id;
 
     void next_valid_index();
 public:
     TSConstIterator(const LabelEquivalenceRelation &label_equivalence_relation,
-                    const std::vector<std::vector<Transition>> &transitions_by_group_id,
+                    const std::vector<Transition> &transitions,
+                    const std::vector<std::size_t> &group_offsets,
                     bool end);
     void operator++();
     GroupAndTransitions operator*() const;
@@ -104,17 +141,18 @@ private:
     std::unique_ptr<LabelEquivalenceRelation> label_equivalence_relation;
 
     /*
-      The transitions of a label group are indexed via its ID. The ID of a
-      group does not change, and hence its transitions are never moved.
-
-      We tested different alternatives to store the transitions, but they all
-      performed worse: storing a vector transitions in the label group increases
-      memory usage and runtime; storing the transitions more compactly and
-      incrementally increasing the size of transitions_of_groups whenever a
-      new label group is added also increases runtime. See also issue492 and
-      issue521.
+      The transitions of all label groups are stored in one contiguous
+      buffer, ordered by group ID. The transitions of the group with ID i
+      are transitions[group_offsets[i], group_offsets[i + 1]). The ID of a
+      group does not change, but its transitions are moved whenever the
+      buffer is compacted.
+
+      Compared to storing one vector per group, this avoids the allocation
+      overhead of many small vectors, and products and abstractions can be
+      written into a single allocation.
     */
-    std::vector<std::vector<Transition>> transitions_by_group_id;
+    std::vector<Transition> transitions;
+    std::vector<std::size_t> group_offsets;
 
     int num_states;
     std::vector<bool> goal_states;
@@ -126,8 +164,15 @@ private:
     */
     void compute_locally_equivalent_labels();
 
-    const std::vector<Transition> &get_transitions_for_group_id(int group_id) const {
-        return transitions_by_group_id[group_id];
+    /*
+      Remove the transitions of all empty label groups from the buffer and
+      release unused memory.
+    */
+    void compact_transitions();
+
+    TransitionRange get_transitions_for_group_id(int group_id) const {
+        return TransitionRange(transitions.data() + group_offsets[group_id],
+                               transitions.data() + group_offsets[group_id + 1]);
     }
 
     // Statistics and output
@@ -142,6 +187,15 @@ public:
         int num_states,
         std::vector<bool> &&goal_states,
         int init_state);
+    TransitionSystem(
+        int num_variables,
+        std::vector<int> &&incorporated_variables,
+        std::unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
+        std::vector<Transition> &&transitions,
+        std::vector<std::size_t> &&group_offsets,
+        int num_states,
+        std::vector<bool> &&goal_states,
+        int init_state);
     TransitionSystem(const TransitionSystem &other);
     ~TransitionSystem();
     /*
@@ -179,13 +233,15 @@ public:
 
     TSConstIterator begin() const {
         return TSConstIterator(*label_equivalence_relation,
-                               transitions_by_group_id,
+                               transitions,
+                               group_offsets,
                                false);
     }
 
     TSConstIterator end() const {
         return TSConstIterator(*label_equivalence_relation,
-                               transitions_by_group_id,
+                               transitions,
+                               group_offsets,
                                true);
     }
 
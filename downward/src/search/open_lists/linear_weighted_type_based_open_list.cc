@@ -1,5 +1,7 @@
 #include "linear_weighted_type_based_open_list.h"
 
+#include "type_based_keys.h"
+
 #include "../evaluator.h"
 #include "../open_list.h"
 #include "../option_parser.h"
@@ -20,12 +22,12 @@
 using namespace std;
 
 namespace linear_weighted_type_based_open_list {
-template<class Entry>
+template<class Entry, class Key>
 class LinearWeightedTypeBasedOpenList : public OpenList<Entry> {
     shared_ptr<utils::RandomNumberGenerator> rng;
     vector<shared_ptr<Evaluator>> evaluators;
+    type_based_keys::KeyEvaluators<Key> key_evaluators;
 
-    using Key = vector<int>;
     using Bucket = vector<Entry>;
     unordered_map<int, vector<pair<Key, Bucket>>> first_to_keys_and_buckets;
     unordered_map<int, utils::HashMap<Key, int>> first_to_key_to_bucket_index;
@@ -53,22 +55,13 @@ public:
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
 };
 
-template<class Entry>
-void LinearWeightedTypeBasedOpenList<Entry>::do_insertion(
+template<class Entry, class Key>
+void LinearWeightedTypeBasedOpenList<Entry, Key>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<int> key;
-    key.reserve(evaluators.size() - 1);
-    bool first = true;
-    int key_first = -1;
-    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
-        if (first) {
-            key_first = eval_context.get_evaluator_value_or_infinity(evaluator.get());
-            first = false;
-        } else {
-            key.push_back(
-                eval_context.get_evaluator_value_or_infinity(evaluator.get()));
-        }
-    }
+    int key_first = eval_context.get_evaluator_value_or_infinity(
+        evaluators[0].get());
+    Key key;
+    key_evaluators.compute_key(eval_context, key);
 
     auto first_it = first_to_key_to_bucket_index.find(key_first);
     if (first_it == first_to_key_to_bucket_index.end()) {
@@ -91,18 +84,19 @@ void LinearWeightedTypeBasedOpenList<Entry>::do_insertion(
     }
 }
 
-template<class Entry>
-LinearWeightedTypeBasedOpenList<Entry>::LinearWeightedTypeBasedOpenList(const Options &opts)
+template<class Entry, class Key>
+LinearWeightedTypeBasedOpenList<Entry, Key>::LinearWeightedTypeBasedOpenList(const Options &opts)
     : rng(utils::parse_rng_from_options(opts)),
       evaluators(opts.get_list<shared_ptr<Evaluator>>("evaluators")),
+      key_evaluators(evaluators, 1),
       alpha(opts.get<double>("alpha")),
       beta(opts.get<double>("beta")),
       ignore_size(opts.get<bool>("ignore_size")),
       ignore_weights(opts.get<bool>("ignore_weights")) {
 }
 
-template<class Entry>
-Entry LinearWeightedTypeBasedOpenList<Entry>::remove_min() {
+template<class Entry, class Key>
+Entry LinearWeightedTypeBasedOpenList<Entry, Key>::remove_min() {
     int key_first = *first_values.begin();
     if (first_values.size() > 1) {
         double r = (*rng)();
@@ -165,20 +159,20 @@ Entry LinearWeightedTypeBasedOpenList<Entry>::remove_min() {
     return result;
 }
 
-template<class Entry>
-bool LinearWeightedTypeBasedOpenList<Entry>::empty() const {
+template<class Entry, class Key>
+bool LinearWeightedTypeBasedOpenList<Entry, Key>::empty() const {
     return first_values.empty();
 }
 
-template<class Entry>
-void LinearWeightedTypeBasedOpenList<Entry>::clear() {
+template<class Entry, class Key>
+void LinearWeightedTypeBasedOpenList<Entry, Key>::clear() {
     first_to_keys_and_buckets.clear();
     first_to_key_to_bucket_index.clear();
     first_to_keys_and_buckets.clear();
 }
 
-template<class Entry>
-bool LinearWeightedTypeBasedOpenList<Entry>::is_dead_end(
+template<class Entry, class Key>
+bool LinearWeightedTypeBasedOpenList<Entry, Key>::is_dead_end(
     EvaluationContext &eval_context) const {
     // If one evaluator is sure we have a dead end, return true.
     if (is_reliable_dead_end(eval_context))
@@ -191,8 +185,8 @@ bool LinearWeightedTypeBasedOpenList<Entry>::is_dead_end(
     return true;
 }
 
-template<class Entry>
-bool LinearWeightedTypeBasedOpenList<Entry>::is_reliable_dead_end(
+template<class Entry, class Key>
+bool LinearWeightedTypeBasedOpenList<Entry, Key>::is_reliable_dead_end(
     EvaluationContext &eval_context) const {
     for (const shared_ptr<Evaluator> &evaluator : evaluators) {
         if (evaluator->dead_ends_are_reliable() &&
@@ -202,8 +196,8 @@ bool LinearWeightedTypeBasedOpenList<Entry>::is_reliable_dead_end(
     return false;
 }
 
-template<class Entry>
-void LinearWeightedTypeBasedOpenList<Entry>::get_path_dependent_evaluators(
+template<class Entry, class Key>
+void LinearWeightedTypeBasedOpenList<Entry, Key>::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (const shared_ptr<Evaluator> &evaluator : evaluators) {
         evaluator->get_path_dependent_evaluators(evals);
@@ -212,17 +206,20 @@ void LinearWeightedTypeBasedOpenList<Entry>::get_path_dependent_evaluators(
 
 LinearWeightedTypeBasedOpenListFactory::LinearWeightedTypeBasedOpenListFactory(
     const Options &options)
-    : options(options) {
+    : options(options),
+      key_size(options.get_list<shared_ptr<Evaluator>>("evaluators").size() - 1) {
 }
 
 unique_ptr<StateOpenList>
 LinearWeightedTypeBasedOpenListFactory::create_state_open_list() {
-    return utils::make_unique_ptr<LinearWeightedTypeBasedOpenList<StateOpenListEntry>>(options);
+    return type_based_keys::create_type_based_open_list<
+        LinearWeightedTypeBasedOpenList, StateOpenListEntry>(options, key_size);
 }
 
 unique_ptr<EdgeOpenList>
 LinearWeightedTypeBasedOpenListFactory::create_edge_open_list() {
-    return utils::make_unique_ptr<LinearWeightedTypeBasedOpenList<EdgeOpenListEntry>>(options);
+    return type_based_keys::create_type_based_open_list<
+        LinearWeightedTypeBasedOpenList, EdgeOpenListEntry>(options, key_size);
 }
 
 static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
@@ -8,6 +8,8 @@
 namespace linear_weighted_type_based_open_list {
 class LinearWeightedTypeBasedOpenListFactory : public OpenListFactory {
     Options options;
+    // Number of evaluators in the keys of the buckets (all but the first).
+    int key_size;
 public:
     explicit LinearWeightedTypeBasedOpenListFactory(const Options &options);
     virtual ~LinearWeightedTypeBasedOpenListFactory() override = default;
@@ -1,5 +1,7 @@
 #include "nth_type_based_open_list.h"
 
+#include "type_based_keys.h"
+
 #include "../evaluator.h"
 #include "../open_list.h"
 #include "../option_parser.h"
@@ -12,6 +14,7 @@
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
+#include <limits>
 #include <map>
 #include <memory>
 #include <unordered_map>
@@ -20,18 +23,19 @@
 using namespace std;
 
 namespace nth_type_based_open_list {
-template<class Entry>
+template<class Entry, class Key>
 class NthTypeBasedOpenList : public OpenList<Entry> {
     shared_ptr<utils::RandomNumberGenerator> rng;
     vector<shared_ptr<Evaluator>> evaluators;
+    type_based_keys::KeyEvaluators<Key> key_evaluators;
 
-    using Key = vector<int>;
     using Bucket = vector<Entry>;
     unordered_map<int, vector<pair<Key, Bucket>>> first_to_keys_and_buckets;
     unordered_map<int, utils::HashMap<Key, int>> first_to_key_to_bucket_index;
     std::set<int> first_values;
 
     int n;
+    int max_difference;
     bool ignore_size;
 
 protected:
@@ -51,22 +55,13 @@ public:
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
 };
 
-template<class Entry>
-void NthTypeBasedOpenList<Entry>::do_insertion(
+template<class Entry, class Key>
+void NthTypeBasedOpenList<Entry, Key>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<int> key;
-    key.reserve(evaluators.size() - 1);
-    bool first = true;
-    int key_first = -1;
-    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
-        if (first) {
-            key_first = eval_context.get_evaluator_value_or_infinity(evaluator.get());
-            first = false;
-        } else {
-            key.push_back(
-                eval_context.get_evaluator_value_or_infinity(evaluator.get()));
-        }
-    }
+    int key_first = eval_context.get_evaluator_value_or_infinity(
+        evaluators[0].get());
+    Key key;
+    key_evaluators.compute_key(eval_context, key);
 
     auto first_it = first_to_key_to_bucket_index.find(key_first);
     if (first_it == first_to_key_to_bucket_index.end()) {
@@ -89,48 +84,61 @@ void NthTypeBasedOpenList<Entry>::do_insertion(
     }
 }
 
-template<class Entry>
-NthTypeBasedOpenList<Entry>::NthTypeBasedOpenList(const Options &opts)
+template<class Entry, class Key>
+NthTypeBasedOpenList<Entry, Key>::NthTypeBasedOpenList(const Options &opts)
     : rng(utils::parse_rng_from_options(opts)),
       evaluators(opts.get_list<shared_ptr<Evaluator>>("evaluators")),
+      key_evaluators(evaluators, 1),
       n(opts.get<int>("n")),
+      max_difference(opts.get<int>("max_difference")),
       ignore_size(opts.get<bool>("ignore_size")) {
 }
 
-template<class Entry>
-Entry NthTypeBasedOpenList<Entry>::remove_min() {
+template<class Entry, class Key>
+Entry NthTypeBasedOpenList<Entry, Key>::remove_min() {
     int key_first = *first_values.begin();
     if (first_values.size() > 1) {
+        // Only values up to the minimum value plus max_difference are candidates.
+        bool restrict_values = max_difference != numeric_limits<int>::max();
+        int max_value = numeric_limits<int>::max();
+        if (restrict_values && key_first <= numeric_limits<int>::max() - max_difference)
+            max_value = key_first + max_difference;
         double current_sum = 0.0;
 
-        if (ignore_size) {
+        if (ignore_size && !restrict_values) {
             current_sum = n;
         } else {
             int i = 0;
             for (auto value : first_values) {
-              if (ignore_size)
-                  current_sum += 1.0;
-              else
-                  current_sum += static_cast<double>(first_to_keys_and_buckets[value].size()); 
-              if (i++ >= n) break;
+                if (value > max_value)
+                    break;
+                if (ignore_size)
+                    current_sum += 1.0;
+                else
+                    current_sum += static_cast<double>(first_to_keys_and_buckets[value].size());
+                if (i++ >= n)
+                    break;
             }
         }
-        
+
         double r = (*rng)();
         double p_sum = 0.0;
         int i = 0;
         for (auto value : first_values) {
-            double p =  1.0 / current_sum;
+            if (value > max_value)
+                break;
+            double p = 1.0 / current_sum;
 
             if (!ignore_size)
-                p *= static_cast<double>(first_to_keys_and_buckets[value].size()); 
+                p *= static_cast<double>(first_to_keys_and_buckets[value].size());
 
             p_sum += p;
             if (r <= p_sum) {
                 key_first = value;
                 break;
             }
-            if (i++ >= n) break;
+            if (i++ >= n)
+                break;
         }
     }
 
@@ -160,20 +168,20 @@ Entry NthTypeBasedOpenList<Entry>::remove_min() {
     return result;
 }
 
-template<class Entry>
-bool NthTypeBasedOpenList<Entry>::empty() const {
+template<class Entry, class Key>
+bool NthTypeBasedOpenList<Entry, Key>::empty() const {
     return first_values.empty();
 }
 
-template<class Entry>
-void NthTypeBasedOpenList<Entry>::clear() {
+template<class Entry, class Key>
+void NthTypeBasedOpenList<Entry, Key>::clear() {
     first_to_keys_and_buckets.clear();
     first_to_key_to_bucket_index.clear();
     first_to_keys_and_buckets.clear();
 }
 
-template<class Entry>
-bool NthTypeBasedOpenList<Entry>::is_dead_end(
+template<class Entry, class Key>
+bool NthTypeBasedOpenList<Entry, Key>::is_dead_end(
     EvaluationContext &eval_context) const {
     // If one evaluator is sure we have a dead end, return true.
     if (is_reliable_dead_end(eval_context))
@@ -186,8 +194,8 @@ bool NthTypeBasedOpenList<Entry>::is_dead_end(
     return true;
 }
 
-template<class Entry>
-bool NthTypeBasedOpenList<Entry>::is_reliable_dead_end(
+template<class Entry, class Key>
+bool NthTypeBasedOpenList<Entry, Key>::is_reliable_dead_end(
     EvaluationContext &eval_context) const {
     for (const shared_ptr<Evaluator> &evaluator : evaluators) {
         if (evaluator->dead_ends_are_reliable() &&
@@ -197,8 +205,8 @@ bool NthTypeBasedOpenList<Entry>::is_reliable_dead_end(
     return false;
 }
 
-template<class Entry>
-void NthTypeBasedOpenList<Entry>::get_path_dependent_evaluators(
+template<class Entry, class Key>
+void NthTypeBasedOpenList<Entry, Key>::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (const shared_ptr<Evaluator> &evaluator : evaluators) {
         evaluator->get_path_dependent_evaluators(evals);
@@ -207,17 +215,20 @@ void NthTypeBasedOpenList<Entry>::get_path_dependent_evaluators(
 
 NthTypeBasedOpenListFactory::NthTypeBasedOpenListFactory(
     const Options &options)
-    : options(options) {
+    : options(options),
+      key_size(options.get_list<shared_ptr<Evaluator>>("evaluators").size() - 1) {
 }
 
 unique_ptr<StateOpenList>
 NthTypeBasedOpenListFactory::create_state_open_list() {
-    return utils::make_unique_ptr<NthTypeBasedOpenList<StateOpenListEntry>>(options);
+    return type_based_keys::create_type_based_open_list<
+        NthTypeBasedOpenList, StateOpenListEntry>(options, key_size);
 }
 
 unique_ptr<EdgeOpenList>
 NthTypeBasedOpenListFactory::create_edge_open_list() {
-    return utils::make_unique_ptr<NthTypeBasedOpenList<EdgeOpenListEntry>>(options);
+    return type_based_keys::create_type_based_open_list<
+        NthTypeBasedOpenList, EdgeOpenListEntry>(options, key_size);
 }
 
 static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
@@ -242,6 +253,12 @@ static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
         "evaluators",
         "Evaluators used to determine the bucket for each entry.");
     parser.add_option<int>("n", "how many h-values to explore", "2");
+    parser.add_option<int>(
+        "max_difference",
+        "only explore h-values that exceed the minimum h-value by at most "
+        "this amount",
+        "infinity",
+        Bounds("0", "infinity"));
     parser.add_option<bool>(
         "ignore_size",
         "ignore size of second to last keys", "false");
@@ -8,6 +8,8 @@
 namespace nth_type_based_open_list {
 class NthTypeBasedOpenListFactory : public OpenListFactory {
     Options options;
+    // Number of evaluators in the keys of the buckets (all but the first).
+    int key_size;
 public:
     explicit NthTypeBasedOpenListFactory(const Options &options);
     virtual ~NthTypeBasedOpenListFactory() override = default;
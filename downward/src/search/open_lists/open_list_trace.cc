@@ -0,0 +1,254 @@
+#include "open_list_trace.h"
+
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+using namespace std;
+using utils::ExitCode;
+
+namespace open_list_trace {
+static const char MAGIC[] = "FDOLTRC2";
+static const size_t MAGIC_LENGTH = sizeof(MAGIC) - 1;
+static const size_t BUFFER_SIZE = 1 << 16;
+
+template<>
+EntryType get_entry_type<StateOpenListEntry>() {
+    return EntryType::STATE;
+}
+
+template<>
+EntryType get_entry_type<EdgeOpenListEntry>() {
+    return EntryType::EDGE;
+}
+
+/*
+  The writers that have not been finished yet. utils::exit_with does not
+  destroy the search engine, so an exit handler finishes these writers.
+*/
+static vector<TraceWriter *> &get_unfinished_writers() {
+    static vector<TraceWriter *> writers;
+    return writers;
+}
+
+static void finish_unfinished_writers() {
+    // Finishing a writer removes it from the vector.
+    vector<TraceWriter *> &writers = get_unfinished_writers();
+    while (!writers.empty()) {
+        writers.back()->finish();
+    }
+}
+
+TraceWriter::TraceWriter(const string &filename, const TraceHeader &header)
+    : file(filename, ios::binary),
+      num_evaluators(header.evaluator_descriptions.size()),
+      finished(false) {
+    if (!file) {
+        cerr << "could not open trace file " << filename << endl;
+        utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    buffer.reserve(BUFFER_SIZE);
+    buffer.insert(buffer.end(), MAGIC, MAGIC + MAGIC_LENGTH);
+    write_unsigned(static_cast<uint64_t>(header.entry_type));
+    write_unsigned(num_evaluators);
+    for (const string &description : header.evaluator_descriptions) {
+        write_string(description);
+    }
+
+    vector<TraceWriter *> &writers = get_unfinished_writers();
+    static bool exit_handler_registered = false;
+    if (!exit_handler_registered) {
+        atexit(finish_unfinished_writers);
+        exit_handler_registered = true;
+    }
+    writers.push_back(this);
+}
+
+TraceWriter::~TraceWriter() {
+    finish();
+}
+
+void TraceWriter::finish() {
+    if (finished)
+        return;
+    finished = true;
+    vector<TraceWriter *> &writers = get_unfinished_writers();
+    writers.erase(find(writers.begin(), writers.end(), this));
+    flush();
+    file.put(static_cast<char>(Operation::END));
+    file.flush();
+}
+
+void TraceWriter::write_unsigned(uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+void TraceWriter::write_signed(int value) {
+    int64_t wide_value = value;
+    write_unsigned((static_cast<uint64_t>(wide_value) << 1) ^
+                   static_cast<uint64_t>(wide_value >> 63));
+}
+
+void TraceWriter::write_string(const string &s) {
+    write_unsigned(s.size());
+    buffer.insert(buffer.end(), s.begin(), s.end());
+}
+
+void TraceWriter::write_operation(Operation operation) {
+    if (buffer.size() >= BUFFER_SIZE)
+        flush();
+    buffer.push_back(static_cast<char>(operation));
+}
+
+void TraceWriter::write_entry(const StateOpenListEntry &entry) {
+    write_unsigned(entry.value);
+}
+
+void TraceWriter::write_entry(const EdgeOpenListEntry &entry) {
+    write_unsigned(entry.first.value);
+    write_unsigned(entry.second.get_index());
+}
+
+void TraceWriter::flush() {
+    file.write(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+
+class TraceParser {
+    const vector<char> &data;
+    size_t pos;
+public:
+    explicit TraceParser(const vector<char> &data)
+        : data(data), pos(0) {
+    }
+
+    bool at_end() const {
+        return pos == data.size();
+    }
+
+    void check(bool condition) const {
+        if (!condition) {
+            cerr << "invalid trace file (at byte " << pos << ")" << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+    }
+
+    uint8_t peek_byte() const {
+        check(pos < data.size());
+        return static_cast<uint8_t>(data[pos]);
+    }
+
+    uint8_t read_byte() {
+        uint8_t byte = peek_byte();
+        ++pos;
+        return byte;
+    }
+
+    uint64_t read_unsigned() {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            check(shift < 64);
+            uint8_t byte = read_byte();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+    }
+
+    int read_signed() {
+        uint64_t value = read_unsigned();
+        return static_cast<int>(
+            static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1));
+    }
+
+    string read_string() {
+        uint64_t length = read_unsigned();
+        check(length <= data.size() - pos);
+        string s(data.begin() + pos, data.begin() + pos + length);
+        pos += length;
+        return s;
+    }
+};
+
+Trace::Trace(const string &filename) {
+    ifstream file(filename, ios::binary);
+    if (!file) {
+        cerr << "could not open trace file " << filename << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    vector<char> data((istreambuf_iterator<char>(file)),
+                      istreambuf_iterator<char>());
+
+    TraceParser parser(data);
+    parser.check(data.size() >= MAGIC_LENGTH &&
+                 equal(MAGIC, MAGIC + MAGIC_LENGTH, data.begin()));
+    for (size_t i = 0; i < MAGIC_LENGTH; ++i) {
+        parser.read_byte();
+    }
+    uint64_t entry_type = parser.read_unsigned();
+    parser.check(entry_type <= static_cast<uint64_t>(EntryType::EDGE));
+    header.entry_type = static_cast<EntryType>(entry_type);
+    uint64_t num_evaluators = parser.read_unsigned();
+    for (uint64_t i = 0; i < num_evaluators; ++i) {
+        header.evaluator_descriptions.push_back(parser.read_string());
+    }
+
+    while (true) {
+        if (parser.at_end()) {
+            cerr << "trace file " << filename << " is truncated (it has no "
+                 << "end marker, e.g., because the search was killed)" << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        if (static_cast<Operation>(parser.peek_byte()) == Operation::END) {
+            parser.read_byte();
+            parser.check(parser.at_end());
+            break;
+        }
+        TraceRecord record;
+        record.operation = static_cast<Operation>(parser.read_byte());
+        record.g = -1;
+        record.key_offset = -1;
+        record.state_id = -1;
+        record.operator_id = -1;
+        switch (record.operation) {
+        case Operation::INSERT:
+        case Operation::INSERT_PREFERRED:
+            record.g = parser.read_signed();
+            record.key_offset = keys.size();
+            for (uint64_t i = 0; i < num_evaluators; ++i) {
+                keys.push_back(parser.read_signed());
+            }
+            record.state_id = parser.read_unsigned();
+            if (header.entry_type == EntryType::EDGE)
+                record.operator_id = parser.read_unsigned();
+            break;
+        case Operation::REMOVE_MIN:
+        case Operation::BOOST_PREFERRED:
+        case Operation::CLEAR:
+            break;
+        default:
+            parser.check(false);
+        }
+        records.push_back(record);
+    }
+}
+
+template<>
+StateOpenListEntry Trace::get_entry(const TraceRecord &record) const {
+    return StateID(record.state_id);
+}
+
+template<>
+EdgeOpenListEntry Trace::get_entry(const TraceRecord &record) const {
+    return make_pair(StateID(record.state_id), OperatorID(record.operator_id));
+}
+}
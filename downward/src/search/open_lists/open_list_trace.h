@@ -0,0 +1,151 @@
+#ifndef OPEN_LISTS_OPEN_LIST_TRACE_H
+#define OPEN_LISTS_OPEN_LIST_TRACE_H
+
+#include "../open_list.h"
+#include "../state_id.h"
+
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+  Binary traces of the operations a search performs on an open list.
+  Traces are written by the "trace" open list and can be replayed on
+  other open lists with the open_list_replay benchmark, so open list
+  implementations can be compared on the workload of a real search
+  without computing any heuristics.
+
+  File format: the magic string "FDOLTRC2", the entry type, the number
+  of evaluators and their descriptions, followed by one record per
+  operation and a final END byte. Each record starts with an operation
+  byte. Insertions are followed by the g value, the key (one value per
+  evaluator) and the entry (state ID and, for edge open lists, the
+  operator ID). All integers are stored as variable-length (LEB128)
+  numbers, signed integers in zig-zag encoding, so typical records take
+  only a few bytes.
+
+  The END byte is written when the writer is destroyed or the planner
+  exits with utils::exit_with (e.g., when running out of memory). Runs
+  that are killed by a signal (e.g., SIGXCPU) cannot finish their trace,
+  and reading a trace without END byte fails.
+*/
+namespace open_list_trace {
+enum class Operation : uint8_t {
+    INSERT = 0,
+    INSERT_PREFERRED = 1,
+    REMOVE_MIN = 2,
+    BOOST_PREFERRED = 3,
+    CLEAR = 4,
+    END = 5
+};
+
+enum class EntryType {
+    STATE = 0,
+    EDGE = 1
+};
+
+template<class Entry>
+EntryType get_entry_type();
+template<>
+EntryType get_entry_type<StateOpenListEntry>();
+template<>
+EntryType get_entry_type<EdgeOpenListEntry>();
+
+struct TraceHeader {
+    EntryType entry_type;
+    std::vector<std::string> evaluator_descriptions;
+};
+
+class TraceWriter {
+    std::ofstream file;
+    std::vector<char> buffer;
+    const int num_evaluators;
+    bool finished;
+
+    void write_unsigned(uint64_t value);
+    void write_signed(int value);
+    void write_string(const std::string &s);
+    void write_operation(Operation operation);
+    void write_entry(const StateOpenListEntry &entry);
+    void write_entry(const EdgeOpenListEntry &entry);
+    void flush();
+public:
+    TraceWriter(const std::string &filename, const TraceHeader &header);
+    ~TraceWriter();
+
+    // Write the END byte and all buffered records to the file.
+    void finish();
+
+    template<class Entry>
+    void write_insertion(
+        const std::vector<int> &key, int g, bool preferred, const Entry &entry) {
+        assert(static_cast<int>(key.size()) == num_evaluators);
+        write_operation(preferred ? Operation::INSERT_PREFERRED : Operation::INSERT);
+        write_signed(g);
+        for (int value : key) {
+            write_signed(value);
+        }
+        write_entry(entry);
+    }
+
+    void write_remove_min() {
+        write_operation(Operation::REMOVE_MIN);
+    }
+
+    void write_boost_preferred() {
+        write_operation(Operation::BOOST_PREFERRED);
+    }
+
+    void write_clear() {
+        write_operation(Operation::CLEAR);
+    }
+};
+
+/*
+  A decoded trace. Insertion records store the index of their key in
+  keys, which holds the keys of all insertions back to back.
+*/
+struct TraceRecord {
+    Operation operation;
+    int g;
+    int key_offset;
+    int state_id;
+    int operator_id;
+};
+
+class Trace {
+    TraceHeader header;
+    std::vector<TraceRecord> records;
+    std::vector<int> keys;
+public:
+    explicit Trace(const std::string &filename);
+
+    const TraceHeader &get_header() const {
+        return header;
+    }
+
+    int get_num_evaluators() const {
+        return header.evaluator_descriptions.size();
+    }
+
+    const std::vector<TraceRecord> &get_records() const {
+        return records;
+    }
+
+    const int *get_key(const TraceRecord &record) const {
+        return keys.data() + record.key_offset;
+    }
+
+    template<class Entry>
+    Entry get_entry(const TraceRecord &record) const;
+};
+
+template<>
+StateOpenListEntry Trace::get_entry(const TraceRecord &record) const;
+template<>
+EdgeOpenListEntry Trace::get_entry(const TraceRecord &record) const;
+}
+
+#endif
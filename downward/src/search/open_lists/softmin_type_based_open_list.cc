@@ -1,5 +1,7 @@
 #include "softmin_type_based_open_list.h"
 
+#include "type_based_keys.h"
+
 #include "../evaluator.h"
 #include "../open_list.h"
 #include "../option_parser.h"
@@ -20,12 +22,12 @@
 using namespace std;
 
 namespace softmin_type_based_open_list {
-template<class Entry>
+template<class Entry, class Key>
 class SoftminTypeBasedOpenList : public OpenList<Entry> {
     shared_ptr<utils::RandomNumberGenerator> rng;
     vector<shared_ptr<Evaluator>> evaluators;
+    type_based_keys::KeyEvaluators<Key> key_evaluators;
 
-    using Key = vector<int>;
     using Bucket = vector<Entry>;
     unordered_map<int, vector<pair<Key, Bucket>>> first_to_keys_and_buckets;
     unordered_map<int, utils::HashMap<Key, int>> first_to_key_to_bucket_index;
@@ -53,22 +55,13 @@ public:
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
 };
 
-template<class Entry>
-void SoftminTypeBasedOpenList<Entry>::do_insertion(
+template<class Entry, class Key>
+void SoftminTypeBasedOpenList<Entry, Key>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<int> key;
-    key.reserve(evaluators.size() - 1);
-    bool first = true;
-    int key_first = -1;
-    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
-        if (first) {
-            key_first = eval_context.get_evaluator_value_or_infinity(evaluator.get());
-            first = false;
-        } else {
-            key.push_back(
-                eval_context.get_evaluator_value_or_infinity(evaluator.get()));
-        }
-    }
+    int key_first = eval_context.get_evaluator_value_or_infinity(
+        evaluators[0].get());
+    Key key;
+    key_evaluators.compute_key(eval_context, key);
 
     auto first_it = first_to_key_to_bucket_index.find(key_first);
     if (first_it == first_to_key_to_bucket_index.end()) {
@@ -106,18 +99,19 @@ void SoftminTypeBasedOpenList<Entry>::do_insertion(
     }
 }
 
-template<class Entry>
-SoftminTypeBasedOpenList<Entry>::SoftminTypeBasedOpenList(const Options &opts)
+template<class Entry, class Key>
+SoftminTypeBasedOpenList<Entry, Key>::SoftminTypeBasedOpenList(const Options &opts)
     : rng(utils::parse_rng_from_options(opts)),
       evaluators(opts.get_list<shared_ptr<Evaluator>>("evaluators")),
+      key_evaluators(evaluators, 1),
       tau(opts.get<double>("tau")),
       ignore_size(opts.get<bool>("ignore_size")),
       ignore_weights(opts.get<bool>("ignore_weights")),
       current_sum(0.0) {
 }
 
-template<class Entry>
-Entry SoftminTypeBasedOpenList<Entry>::remove_min() {
+template<class Entry, class Key>
+Entry SoftminTypeBasedOpenList<Entry, Key>::remove_min() {
     int key_first = *first_values.begin();
     if (first_values.size() > 1) {
         double r = (*rng)();
@@ -182,20 +176,20 @@ Entry SoftminTypeBasedOpenList<Entry>::remove_min() {
     return result;
 }
 
-template<class Entry>
-bool SoftminTypeBasedOpenList<Entry>::empty() const {
+template<class Entry, class Key>
+bool SoftminTypeBasedOpenList<Entry, Key>::empty() const {
     return first_values.empty();
 }
 
-template<class Entry>
-void SoftminTypeBasedOpenList<Entry>::clear() {
+template<class Entry, class Key>
+void SoftminTypeBasedOpenList<Entry, Key>::clear() {
     first_to_keys_and_buckets.clear();
     first_to_key_to_bucket_index.clear();
     first_to_keys_and_buckets.clear();
 }
 
-template<class Entry>
-bool SoftminTypeBasedOpenList<Entry>::is_dead_end(
+template<class Entry, class Key>
+bool SoftminTypeBasedOpenList<Entry, Key>::is_dead_end(
     EvaluationContext &eval_context) const {
     // If one evaluator is sure we have a dead end, return true.
     if (is_reliable_dead_end(eval_context))
@@ -208,8 +202,8 @@ bool SoftminTypeBasedOpenList<Entry>::is_dead_end(
     return true;
 }
 
-template<class Entry>
-bool SoftminTypeBasedOpenList<Entry>::is_reliable_dead_end(
+template<class Entry, class Key>
+bool SoftminTypeBasedOpenList<Entry, Key>::is_reliable_dead_end(
     EvaluationContext &eval_context) const {
     for (const shared_ptr<Evaluator> &evaluator : evaluators) {
         if (evaluator->dead_ends_are_reliable() &&
@@ -219,8 +213,8 @@ bool SoftminTypeBasedOpenList<Entry>::is_reliable_dead_end(
     return false;
 }
 
-template<class Entry>
-void SoftminTypeBasedOpenList<Entry>::get_path_dependent_evaluators(
+template<class Entry, class Key>
+void SoftminTypeBasedOpenList<Entry, Key>::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (const shared_ptr<Evaluator> &evaluator : evaluators) {
         evaluator->get_path_dependent_evaluators(evals);
@@ -229,17 +223,20 @@ void SoftminTypeBasedOpenList<Entry>::get_path_dependent_evaluators(
 
 SoftminTypeBasedOpenListFactory::SoftminTypeBasedOpenListFactory(
     const Options &options)
-    : options(options) {
+    : options(options),
+      key_size(options.get_list<shared_ptr<Evaluator>>("evaluators").size() - 1) {
 }
 
 unique_ptr<StateOpenList>
 SoftminTypeBasedOpenListFactory::create_state_open_list() {
-    return utils::make_unique_ptr<SoftminTypeBasedOpenList<StateOpenListEntry>>(options);
+    return type_based_keys::create_type_based_open_list<
+        SoftminTypeBasedOpenList, StateOpenListEntry>(options, key_size);
 }
 
 unique_ptr<EdgeOpenList>
 SoftminTypeBasedOpenListFactory::create_edge_open_list() {
-    return utils::make_unique_ptr<SoftminTypeBasedOpenList<EdgeOpenListEntry>>(options);
+    return type_based_keys::create_type_based_open_list<
+        SoftminTypeBasedOpenList, EdgeOpenListEntry>(options, key_size);
 }
 
 static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
@@ -8,6 +8,8 @@
 namespace softmin_type_based_open_list {
 class SoftminTypeBasedOpenListFactory : public OpenListFactory {
     Options options;
+    // Number of evaluators in the keys of the buckets (all but the first).
+    int key_size;
 public:
     explicit SoftminTypeBasedOpenListFactory(const Options &options);
     virtual ~SoftminTypeBasedOpenListFactory() override = default;
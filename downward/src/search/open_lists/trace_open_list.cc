@@ -0,0 +1,172 @@
+#include "trace_open_list.h"
+
+#include "open_list_trace.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/memory.h"
+
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+namespace trace_open_list {
+template<class Entry>
+class TraceOpenList : public OpenList<Entry> {
+    unique_ptr<OpenList<Entry>> open_list;
+    vector<shared_ptr<Evaluator>> evaluators;
+    open_list_trace::TraceWriter writer;
+
+    TraceOpenList(const Options &opts, unique_ptr<OpenList<Entry>> open_list);
+    static open_list_trace::TraceHeader create_header(
+        const vector<shared_ptr<Evaluator>> &evaluators);
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit TraceOpenList(const Options &opts);
+    virtual ~TraceOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void boost_preferred() override;
+    virtual void get_path_dependent_evaluators(
+        set<Evaluator *> &evals) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+TraceOpenList<Entry>::TraceOpenList(const Options &opts)
+    : TraceOpenList(
+          opts,
+          opts.get<shared_ptr<OpenListFactory>>("open_list")->
+          create_open_list<Entry>()) {
+}
+
+template<class Entry>
+TraceOpenList<Entry>::TraceOpenList(
+    const Options &opts, unique_ptr<OpenList<Entry>> open_list)
+    : OpenList<Entry>(open_list->only_contains_preferred_entries()),
+      open_list(move(open_list)),
+      evaluators(opts.get_list<shared_ptr<Evaluator>>("evals")),
+      writer(opts.get<string>("trace_file"), create_header(evaluators)) {
+}
+
+template<class Entry>
+open_list_trace::TraceHeader TraceOpenList<Entry>::create_header(
+    const vector<shared_ptr<Evaluator>> &evaluators) {
+    open_list_trace::TraceHeader header;
+    header.entry_type = open_list_trace::get_entry_type<Entry>();
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        header.evaluator_descriptions.push_back(evaluator->get_description());
+    return header;
+}
+
+template<class Entry>
+void TraceOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    vector<int> key;
+    key.reserve(evaluators.size());
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        key.push_back(
+            eval_context.get_evaluator_value_or_infinity(evaluator.get()));
+    writer.write_insertion(
+        key, eval_context.get_g_value(), eval_context.is_preferred(), entry);
+    open_list->insert(eval_context, entry);
+}
+
+template<class Entry>
+Entry TraceOpenList<Entry>::remove_min() {
+    writer.write_remove_min();
+    return open_list->remove_min();
+}
+
+template<class Entry>
+bool TraceOpenList<Entry>::empty() const {
+    return open_list->empty();
+}
+
+template<class Entry>
+void TraceOpenList<Entry>::clear() {
+    writer.write_clear();
+    open_list->clear();
+}
+
+template<class Entry>
+void TraceOpenList<Entry>::boost_preferred() {
+    writer.write_boost_preferred();
+    open_list->boost_preferred();
+}
+
+template<class Entry>
+void TraceOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    open_list->get_path_dependent_evaluators(evals);
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+}
+
+template<class Entry>
+bool TraceOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    return open_list->is_dead_end(eval_context);
+}
+
+template<class Entry>
+bool TraceOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    return open_list->is_reliable_dead_end(eval_context);
+}
+
+
+TraceOpenListFactory::TraceOpenListFactory(const Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+TraceOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<TraceOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+TraceOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<TraceOpenList<EdgeOpenListEntry>>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Trace open list",
+        "Records all operations on the given open list in a binary trace "
+        "file and otherwise behaves like the given open list. Insertions "
+        "are recorded together with the values of the given evaluators, "
+        "the g value and the preferredness of the entry. Entries that the "
+        "open list considers dead ends are not recorded. The trace can be "
+        "replayed on other open lists with the open_list_replay "
+        "benchmark, which is built together with the planner.");
+    parser.add_option<shared_ptr<OpenListFactory>>(
+        "open_list", "open list whose operations are recorded");
+    parser.add_list_option<shared_ptr<Evaluator>>(
+        "evals",
+        "evaluators whose values are recorded for each insertion");
+    parser.add_option<string>(
+        "trace_file", "file the trace is written to", "open_list.trace");
+
+    Options opts = parser.parse();
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<TraceOpenListFactory>(opts);
+}
+
+static Plugin<OpenListFactory> _plugin("trace", _parse);
+}
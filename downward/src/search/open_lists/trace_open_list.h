@@ -0,0 +1,19 @@
+#ifndef OPEN_LISTS_TRACE_OPEN_LIST_H
+#define OPEN_LISTS_TRACE_OPEN_LIST_H
+
+#include "../open_list_factory.h"
+#include "../option_parser_util.h"
+
+namespace trace_open_list {
+class TraceOpenListFactory : public OpenListFactory {
+    Options options;
+public:
+    explicit TraceOpenListFactory(const Options &options);
+    virtual ~TraceOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef OPEN_LISTS_TYPE_BASED_KEYS_H
+#define OPEN_LISTS_TYPE_BASED_KEYS_H
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../open_list.h"
+#include "../option_parser_util.h"
+
+#include "../utils/memory.h"
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+/*
+  Keys of the buckets of type-based open lists.
+
+  Almost all configurations use type-based open lists with one to four
+  evaluators. For these, the open lists are instantiated with
+  std::array keys, which avoids allocating a vector for every insertion
+  and lets the compiler unroll computing, comparing and hashing keys.
+  KeyEvaluators<Key> computes keys of type Key from the evaluators
+  starting at a given position (the softmin-style open lists treat the
+  first evaluator separately) through raw pointers; the open lists keep
+  the shared pointers for ownership.
+
+  create_type_based_open_list selects the key type based on the number
+  of key evaluators, so the user-facing syntax does not change.
+*/
+namespace type_based_keys {
+const int MAX_FIXED_KEY_SIZE = 4;
+
+template<class Key>
+class KeyEvaluators;
+
+template<>
+class KeyEvaluators<std::vector<int>> {
+    std::vector<Evaluator *> evaluators;
+public:
+    KeyEvaluators(
+        const std::vector<std::shared_ptr<Evaluator>> &all_evaluators,
+        int first) {
+        for (std::size_t i = first; i < all_evaluators.size(); ++i) {
+            evaluators.push_back(all_evaluators[i].get());
+        }
+    }
+
+    void compute_key(
+        EvaluationContext &eval_context, std::vector<int> &key) const {
+        key.clear();
+        key.reserve(evaluators.size());
+        for (Evaluator *evaluator : evaluators) {
+            key.push_back(
+                eval_context.get_evaluator_value_or_infinity(evaluator));
+        }
+    }
+};
+
+template<std::size_t N>
+class KeyEvaluators<std::array<int, N>> {
+    std::array<Evaluator *, N> evaluators;
+public:
+    KeyEvaluators(
+        const std::vector<std::shared_ptr<Evaluator>> &all_evaluators,
+        int first) {
+        assert(all_evaluators.size() == first + N);
+        for (std::size_t i = 0; i < N; ++i) {
+            evaluators[i] = all_evaluators[first + i].get();
+        }
+    }
+
+    void compute_key(
+        EvaluationContext &eval_context, std::array<int, N> &key) const {
+        for (std::size_t i = 0; i < N; ++i) {
+            key[i] = eval_context.get_evaluator_value_or_infinity(
+                evaluators[i]);
+        }
+    }
+};
+
+/*
+  Create OpenListType<Entry, Key> where Key is std::array<int, key_size>
+  if key_size is at most MAX_FIXED_KEY_SIZE and std::vector<int>
+  otherwise.
+*/
+template<template<class, class> class OpenListType, class Entry>
+std::unique_ptr<OpenList<Entry>> create_type_based_open_list(
+    const Options &opts, int key_size) {
+    switch (key_size) {
+    case 0:
+        return utils::make_unique_ptr<
+            OpenListType<Entry, std::array<int, 0>>>(opts);
+    case 1:
+        return utils::make_unique_ptr<
+            OpenListType<Entry, std::array<int, 1>>>(opts);
+    case 2:
+        return utils::make_unique_ptr<
+            OpenListType<Entry, std::array<int, 2>>>(opts);
+    case 3:
+        return utils::make_unique_ptr<
+            OpenListType<Entry, std::array<int, 3>>>(opts);
+    case 4:
+        return utils::make_unique_ptr<
+            OpenListType<Entry, std::array<int, 4>>>(opts);
+    default:
+        assert(key_size > MAX_FIXED_KEY_SIZE);
+        return utils::make_unique_ptr<
+            OpenListType<Entry, std::vector<int>>>(opts);
+    }
+}
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "type_based_open_list.h"
 
+#include "type_based_keys.h"
+
 #include "../evaluator.h"
 #include "../open_list.h"
 #include "../option_parser.h"
@@ -19,12 +21,12 @@
 using namespace std;
 
 namespace type_based_open_list {
-template<class Entry>
+template<class Entry, class Key>
 class TypeBasedOpenList : public OpenList<Entry> {
     shared_ptr<utils::RandomNumberGenerator> rng;
     vector<shared_ptr<Evaluator>> evaluators;
+    type_based_keys::KeyEvaluators<Key> key_evaluators;
 
-    using Key = vector<int>;
     using Bucket = vector<Entry>;
     vector<pair<Key, Bucket>> keys_and_buckets;
     utils::HashMap<Key, int> key_to_bucket_index;
@@ -46,15 +48,11 @@ public:
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
 };
 
-template<class Entry>
-void TypeBasedOpenList<Entry>::do_insertion(
+template<class Entry, class Key>
+void TypeBasedOpenList<Entry, Key>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<int> key;
-    key.reserve(evaluators.size());
-    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
-        key.push_back(
-            eval_context.get_evaluator_value_or_infinity(evaluator.get()));
-    }
+    Key key;
+    key_evaluators.compute_key(eval_context, key);
 
     auto it = key_to_bucket_index.find(key);
     if (it == key_to_bucket_index.end()) {
@@ -67,14 +65,15 @@ void TypeBasedOpenList<Entry>::do_insertion(
     }
 }
 
-template<class Entry>
-TypeBasedOpenList<Entry>::TypeBasedOpenList(const Options &opts)
+template<class Entry, class Key>
+TypeBasedOpenList<Entry, Key>::TypeBasedOpenList(const Options &opts)
     : rng(utils::parse_rng_from_options(opts)),
-      evaluators(opts.get_list<shared_ptr<Evaluator>>("evaluators")) {
+      evaluators(opts.get_list<shared_ptr<Evaluator>>("evaluators")),
+      key_evaluators(evaluators, 0) {
 }
 
-template<class Entry>
-Entry TypeBasedOpenList<Entry>::remove_min() {
+template<class Entry, class Key>
+Entry TypeBasedOpenList<Entry, Key>::remove_min() {
     size_t bucket_id = (*rng)(keys_and_buckets.size());
     auto &key_and_bucket = keys_and_buckets[bucket_id];
     const Key &min_key = key_and_bucket.first;
@@ -91,19 +90,19 @@ Entry TypeBasedOpenList<Entry>::remove_min() {
     return result;
 }
 
-template<class Entry>
-bool TypeBasedOpenList<Entry>::empty() const {
+template<class Entry, class Key>
+bool TypeBasedOpenList<Entry, Key>::empty() const {
     return keys_and_buckets.empty();
 }
 
-template<class Entry>
-void TypeBasedOpenList<Entry>::clear() {
+template<class Entry, class Key>
+void TypeBasedOpenList<Entry, Key>::clear() {
     keys_and_buckets.clear();
     key_to_bucket_index.clear();
 }
 
-template<class Entry>
-bool TypeBasedOpenList<Entry>::is_dead_end(
+template<class Entry, class Key>
+bool TypeBasedOpenList<Entry, Key>::is_dead_end(
     EvaluationContext &eval_context) const {
     // If one evaluator is sure we have a dead end, return true.
     if (is_reliable_dead_end(eval_context))
@@ -116,8 +115,8 @@ bool TypeBasedOpenList<Entry>::is_dead_end(
     return true;
 }
 
-template<class Entry>
-bool TypeBasedOpenList<Entry>::is_reliable_dead_end(
+template<class Entry, class Key>
+bool TypeBasedOpenList<Entry, Key>::is_reliable_dead_end(
     EvaluationContext &eval_context) const {
     for (const shared_ptr<Evaluator> &evaluator : evaluators) {
         if (evaluator->dead_ends_are_reliable() &&
@@ -127,8 +126,8 @@ bool TypeBasedOpenList<Entry>::is_reliable_dead_end(
     return false;
 }
 
-template<class Entry>
-void TypeBasedOpenList<Entry>::get_path_dependent_evaluators(
+template<class Entry, class Key>
+void TypeBasedOpenList<Entry, Key>::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (const shared_ptr<Evaluator> &evaluator : evaluators) {
         evaluator->get_path_dependent_evaluators(evals);
@@ -137,17 +136,20 @@ void TypeBasedOpenList<Entry>::get_path_dependent_evaluators(
 
 TypeBasedOpenListFactory::TypeBasedOpenListFactory(
     const Options &options)
-    : options(options) {
+    : options(options),
+      key_size(options.get_list<shared_ptr<Evaluator>>("evaluators").size()) {
 }
 
 unique_ptr<StateOpenList>
 TypeBasedOpenListFactory::create_state_open_list() {
-    return utils::make_unique_ptr<TypeBasedOpenList<StateOpenListEntry>>(options);
+    return type_based_keys::create_type_based_open_list<
+        TypeBasedOpenList, StateOpenListEntry>(options, key_size);
 }
 
 unique_ptr<EdgeOpenList>
 TypeBasedOpenListFactory::create_edge_open_list() {
-    return utils::make_unique_ptr<TypeBasedOpenList<EdgeOpenListEntry>>(options);
+    return type_based_keys::create_type_based_open_list<
+        TypeBasedOpenList, EdgeOpenListEntry>(options, key_size);
 }
 
 static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
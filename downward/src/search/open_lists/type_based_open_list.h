@@ -27,6 +27,8 @@
 namespace type_based_open_list {
 class TypeBasedOpenListFactory : public OpenListFactory {
     Options options;
+    // Number of evaluators in the keys of the buckets.
+    int key_size;
 public:
     explicit TypeBasedOpenListFactory(const Options &options);
     virtual ~TypeBasedOpenListFactory() override = default;
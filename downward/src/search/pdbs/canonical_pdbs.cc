@@ -2,6 +2,8 @@
 
 #include "pattern_database.h"
 
+#include "../task_proxy.h"
+
 #include <algorithm>
 #include <cassert>
 #include <iostream>
@@ -16,26 +18,69 @@ CanonicalPDBs::CanonicalPDBs(
     : pdbs(pdbs), pattern_cliques(pattern_cliques) {
     assert(pdbs);
     assert(pattern_cliques);
+
+    num_pdbs = pdbs->size();
+    max_pattern_size = 0;
+    pdb_pointers.reserve(num_pdbs);
+    for (const shared_ptr<PatternDatabase> &pdb : *pdbs) {
+        pdb_pointers.push_back(pdb.get());
+        max_pattern_size = max(
+            max_pattern_size, static_cast<int>(pdb->get_pattern().size()));
+    }
+
+    index_variables.assign(max_pattern_size * num_pdbs, 0);
+    index_multipliers.assign(max_pattern_size * num_pdbs, 0);
+    for (int i = 0; i < num_pdbs; ++i) {
+        const Pattern &pattern = pdb_pointers[i]->get_pattern();
+        const vector<size_t> &hash_multipliers =
+            pdb_pointers[i]->get_hash_multipliers();
+        for (size_t j = 0; j < pattern.size(); ++j) {
+            index_variables[j * num_pdbs + i] = pattern[j];
+            index_multipliers[j * num_pdbs + i] = hash_multipliers[j];
+        }
+    }
+
+    clique_offsets.reserve(pattern_cliques->size() + 1);
+    clique_offsets.push_back(0);
+    for (const PatternClique &clique : *pattern_cliques) {
+        clique_pdbs.insert(clique_pdbs.end(), clique.begin(), clique.end());
+        clique_offsets.push_back(clique_pdbs.size());
+    }
 }
 
 int CanonicalPDBs::get_value(const State &state) const {
     // If we have an empty collection, then pattern_cliques = { \emptyset }.
     assert(!pattern_cliques->empty());
-    int max_h = 0;
-    vector<int> h_values;
-    h_values.reserve(pdbs->size());
     state.unpack();
-    for (const shared_ptr<PatternDatabase> &pdb : *pdbs) {
-        int h = pdb->get_value(state.get_unpacked_values());
-        if (h == numeric_limits<int>::max()) {
-            return numeric_limits<int>::max();
+    const vector<int> &values = state.get_unpacked_values();
+
+    vector<int> h_values(num_pdbs, 0);
+    // Compute the abstract state indices of all PDBs.
+    for (int j = 0; j < max_pattern_size; ++j) {
+        const int *variables = &index_variables[j * num_pdbs];
+        const int *multipliers = &index_multipliers[j * num_pdbs];
+        for (int i = 0; i < num_pdbs; ++i) {
+            h_values[i] += multipliers[i] * values[variables[i]];
         }
-        h_values.push_back(h);
     }
-    for (const PatternClique &clique : *pattern_cliques) {
+
+    // Replace the indices by the h-values.
+    bool dead_end = false;
+    for (int i = 0; i < num_pdbs; ++i) {
+        int h = pdb_pointers[i]->get_distance(h_values[i]);
+        dead_end |= (h == numeric_limits<int>::max());
+        h_values[i] = h;
+    }
+    if (dead_end) {
+        return numeric_limits<int>::max();
+    }
+
+    int max_h = 0;
+    int num_cliques = clique_offsets.size() - 1;
+    for (int clique = 0; clique < num_cliques; ++clique) {
         int clique_h = 0;
-        for (PatternID pdb_index : clique) {
-            clique_h += h_values[pdb_index];
+        for (int k = clique_offsets[clique]; k < clique_offsets[clique + 1]; ++k) {
+            clique_h += h_values[clique_pdbs[k]];
         }
         max_h = max(max_h, clique_h);
     }
@@ -4,14 +4,37 @@
 #include "types.h"
 
 #include <memory>
+#include <vector>
 
 class State;
 
 namespace pdbs {
+/*
+  The canonical heuristic is evaluated in one fused pass: first the
+  abstract state indices of all PDBs are computed column by column from a
+  (variable, multiplier) matrix, then the h-values are looked up, and
+  finally the maximum over the clique sums is computed on flat arrays.
+  All loops run over contiguous arrays without branches so that the
+  compiler can vectorize them.
+*/
 class CanonicalPDBs {
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
 
+    int num_pdbs;
+    int max_pattern_size;
+    std::vector<const PatternDatabase *> pdb_pointers;
+    /*
+      index_variables[j * num_pdbs + i] is the j-th variable of the pattern
+      of PDB i and index_multipliers[j * num_pdbs + i] its hash multiplier.
+      Shorter patterns are padded with variable 0 and multiplier 0.
+    */
+    std::vector<int> index_variables;
+    std::vector<int> index_multipliers;
+    // Clique i consists of clique_pdbs[clique_offsets[i], clique_offsets[i + 1]).
+    std::vector<int> clique_pdbs;
+    std::vector<int> clique_offsets;
+
 public:
     CanonicalPDBs(
         const std::shared_ptr<PDBCollection> &pdbs,
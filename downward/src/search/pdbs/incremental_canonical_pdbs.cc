@@ -1,8 +1,9 @@
 #include "incremental_canonical_pdbs.h"
 
-#include "canonical_pdbs.h"
 #include "pattern_database.h"
 
+#include "../utils/memory.h"
+
 using namespace std;
 
 namespace pdbs {
@@ -36,17 +37,18 @@ void IncrementalCanonicalPDBs::add_pdb(const shared_ptr<PatternDatabase> &pdb) {
 void IncrementalCanonicalPDBs::recompute_pattern_cliques() {
     pattern_cliques = compute_pattern_cliques(*patterns,
                                               are_additive);
+    canonical_pdbs = utils::make_unique_ptr<CanonicalPDBs>(
+        pattern_databases, pattern_cliques);
 }
 
 vector<PatternClique> IncrementalCanonicalPDBs::get_pattern_cliques(
-    const Pattern &new_pattern) {
+    const Pattern &new_pattern) const {
     return pdbs::compute_pattern_cliques_with_pattern(
         *patterns, *pattern_cliques, new_pattern, are_additive);
 }
 
 int IncrementalCanonicalPDBs::get_value(const State &state) const {
-    CanonicalPDBs canonical_pdbs(pattern_databases, pattern_cliques);
-    return canonical_pdbs.get_value(state);
+    return canonical_pdbs->get_value(state);
 }
 
 bool IncrementalCanonicalPDBs::is_dead_end(const State &state) const {
@@ -3,12 +3,15 @@
 #include "../utils/logging.h"
 
 #include <cassert>
+#include <deque>
 #include <iostream>
 #include <utility>
 
 using namespace std;
 
 namespace pdbs {
+const int MatchTree::NO_NODE;
+
 struct MatchTree::Node {
     static const int LEAF_NODE = -1;
     Node();
@@ -129,80 +132,137 @@ void MatchTree::insert_recursive(
 }
 
 void MatchTree::insert(int op_id, const vector<FactPair> &regression_preconditions) {
+    assert(flat_nodes.empty());
     insert_recursive(op_id, regression_preconditions, 0, &root);
 }
 
-void MatchTree::get_applicable_operator_ids_recursive(
-    Node *node, const size_t state_index, vector<int> &operator_ids) const {
-    /*
-      Note: different from the code that builds the match tree, we do
-      the test if node == 0 *before* calling traverse rather than *at
-      the start* of traverse since this turned out to be faster in
-      some informal experiments.
-     */
-
-    operator_ids.insert(operator_ids.end(),
-                        node->applicable_operator_ids.begin(),
-                        node->applicable_operator_ids.end());
-
-    if (node->is_leaf_node())
+void MatchTree::finalize() {
+    assert(flat_nodes.empty());
+    if (!root)
         return;
+    /*
+      Number the nodes in breadth-first order. A node is numbered when it
+      is added to the queue, so the children of a node are numbered
+      before its grandchildren. Every node is freed as soon as it is
+      converted, so the two representations are not fully alive at the
+      same time.
+    */
+    deque<Node *> queue;
+    queue.push_back(root);
+    root = nullptr;
+    int num_nodes = 1;
+    while (!queue.empty()) {
+        Node *node = queue.front();
+        queue.pop_front();
 
-    int temp = state_index / hash_multipliers[node->var_id];
-    int val = temp % node->var_domain_size;
-
-    if (node->successors[val]) {
-        // Follow the correct successor edge, if it exists.
-        get_applicable_operator_ids_recursive(
-            node->successors[val], state_index, operator_ids);
-    }
-    if (node->star_successor) {
-        // Always follow the star edge, if it exists.
-        get_applicable_operator_ids_recursive(
-            node->star_successor, state_index, operator_ids);
+        FlatNode flat_node;
+        flat_node.var_id = node->var_id;
+        flat_node.var_domain_size = node->var_domain_size;
+        flat_node.hash_multiplier = node->is_leaf_node() ?
+            0 : hash_multipliers[node->var_id];
+        flat_node.operators_begin = flat_operator_ids.size();
+        flat_operator_ids.insert(flat_operator_ids.end(),
+                                 node->applicable_operator_ids.begin(),
+                                 node->applicable_operator_ids.end());
+        flat_node.operators_end = flat_operator_ids.size();
+        flat_node.successors_begin = flat_successors.size();
+        flat_node.star_successor = NO_NODE;
+        if (!node->is_leaf_node()) {
+            for (int val = 0; val < node->var_domain_size; ++val) {
+                Node *successor = node->successors[val];
+                if (successor) {
+                    flat_successors.push_back(num_nodes++);
+                    queue.push_back(successor);
+                    // Detach the child so that deleting node keeps it.
+                    node->successors[val] = nullptr;
+                } else {
+                    flat_successors.push_back(NO_NODE);
+                }
+            }
+            if (node->star_successor) {
+                flat_node.star_successor = num_nodes++;
+                queue.push_back(node->star_successor);
+                node->star_successor = nullptr;
+            }
+        }
+        flat_nodes.push_back(flat_node);
+        delete node;
     }
+    assert(static_cast<int>(flat_nodes.size()) == num_nodes);
+
+    /*
+      Variable IDs strictly increase along every path, so a depth-first
+      traversal has at most one pending star successor per variable.
+    */
+    open_nodes.resize(pattern.size() + 2);
 }
 
 void MatchTree::get_applicable_operator_ids(
     size_t state_index, vector<int> &operator_ids) const {
-    if (root)
-        get_applicable_operator_ids_recursive(root, state_index, operator_ids);
-}
-
-void MatchTree::dump_recursive(Node *node) const {
-    if (!node) {
-        // Node is the root node.
-        utils::g_log << "Empty MatchTree" << endl;
+    assert(!root);
+    if (flat_nodes.empty())
         return;
+
+    /*
+      Traverse the tree depth-first. The star successor is pushed before
+      the value successor, so operators are reported in the same order as
+      by a recursive traversal.
+    */
+    int *stack = open_nodes.data();
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+        const FlatNode &node = flat_nodes[stack[--stack_size]];
+
+        operator_ids.insert(operator_ids.end(),
+                            flat_operator_ids.begin() + node.operators_begin,
+                            flat_operator_ids.begin() + node.operators_end);
+
+        if (node.var_id == Node::LEAF_NODE)
+            continue;
+
+        if (node.star_successor != NO_NODE) {
+            stack[stack_size++] = node.star_successor;
+        }
+        int val = (state_index / node.hash_multiplier) % node.var_domain_size;
+        int successor = flat_successors[node.successors_begin + val];
+        if (successor != NO_NODE) {
+            stack[stack_size++] = successor;
+        }
+        assert(stack_size <= static_cast<int>(open_nodes.size()));
     }
+}
+
+void MatchTree::dump_recursive(int node_id) const {
+    const FlatNode &node = flat_nodes[node_id];
     utils::g_log << endl;
-    utils::g_log << "node->var_id = " << node->var_id << endl;
+    utils::g_log << "node->var_id = " << node.var_id << endl;
     utils::g_log << "Number of applicable operators at this node: "
-                 << node->applicable_operator_ids.size() << endl;
-    for (int op_id : node->applicable_operator_ids) {
-        utils::g_log << "AbstractOperator #" << op_id << endl;
+                 << node.operators_end - node.operators_begin << endl;
+    for (int i = node.operators_begin; i < node.operators_end; ++i) {
+        utils::g_log << "AbstractOperator #" << flat_operator_ids[i] << endl;
     }
-    if (node->is_leaf_node()) {
+    if (node.var_id == Node::LEAF_NODE) {
         utils::g_log << "leaf node." << endl;
-        assert(!node->successors);
-        assert(!node->star_successor);
+        assert(node.star_successor == NO_NODE);
     } else {
-        for (int val = 0; val < node->var_domain_size; ++val) {
-            if (node->successors[val]) {
+        for (int val = 0; val < node.var_domain_size; ++val) {
+            int successor = flat_successors[node.successors_begin + val];
+            if (successor != NO_NODE) {
                 utils::g_log << "recursive call for child with value " << val << endl;
-                dump_recursive(node->successors[val]);
+                dump_recursive(successor);
                 utils::g_log << "back from recursive call (for successors[" << val
-                             << "]) to node with var_id = " << node->var_id
+                             << "]) to node with var_id = " << node.var_id
                              << endl;
             } else {
                 utils::g_log << "no child for value " << val << endl;
             }
         }
-        if (node->star_successor) {
+        if (node.star_successor != NO_NODE) {
             utils::g_log << "recursive call for star_successor" << endl;
-            dump_recursive(node->star_successor);
+            dump_recursive(node.star_successor);
             utils::g_log << "back from recursive call (for star_successor) "
-                         << "to node with var_id = " << node->var_id << endl;
+                         << "to node with var_id = " << node.var_id << endl;
         } else {
             utils::g_log << "no star_successor" << endl;
         }
@@ -210,6 +270,11 @@ void MatchTree::dump_recursive(Node *node) const {
 }
 
 void MatchTree::dump() const {
-    dump_recursive(root);
+    assert(!root);
+    if (flat_nodes.empty()) {
+        utils::g_log << "Empty MatchTree" << endl;
+        return;
+    }
+    dump_recursive(0);
 }
 }
@@ -12,6 +12,12 @@ namespace pdbs {
 /*
   Successor Generator for abstract operators.
 
+  The tree is built as a pointer-based tree with insert. Before the first
+  query, finalize converts it into flat arrays in breadth-first order, in
+  which the operators of each node form a contiguous range, and frees the
+  pointer-based tree. Queries then traverse the flat arrays without
+  recursion.
+
   NOTE: MatchTree keeps a reference to the task proxy passed to the constructor.
   Therefore, users of the class must ensure that the task lives at least as long
   as the match tree.
@@ -20,17 +26,36 @@ namespace pdbs {
 class MatchTree {
     TaskProxy task_proxy;
     struct Node;
+    static const int NO_NODE = -1;
+    struct FlatNode {
+        // Index of the variable in the pattern or Node::LEAF_NODE.
+        int var_id;
+        int var_domain_size;
+        std::size_t hash_multiplier;
+        // Operators of the node: flat_operator_ids[operators_begin, operators_end).
+        int operators_begin;
+        int operators_end;
+        // Child for value v: flat_successors[successors_begin + v] or NO_NODE.
+        int successors_begin;
+        int star_successor;
+    };
     // See PatternDatabase for documentation on pattern and hash_multipliers.
     Pattern pattern;
     std::vector<size_t> hash_multipliers;
+    // Pointer-based tree used during construction. Freed by finalize.
     Node *root;
+
+    std::vector<FlatNode> flat_nodes;
+    std::vector<int> flat_operator_ids;
+    std::vector<int> flat_successors;
+    // Stack for queries, so concurrent queries on one tree are not allowed.
+    mutable std::vector<int> open_nodes;
+
     void insert_recursive(int op_id,
                           const std::vector<FactPair> &regression_preconditions,
                           int pre_index,
                           Node **edge_from_parent);
-    void get_applicable_operator_ids_recursive(
-        Node *node, size_t state_index, std::vector<int> &operator_ids) const;
-    void dump_recursive(Node *node) const;
+    void dump_recursive(int node_id) const;
 public:
     // Initialize an empty match tree.
     MatchTree(const TaskProxy &task_proxy,
@@ -41,6 +66,12 @@ public:
        enlarging it. */
     void insert(int op_id, const std::vector<FactPair> &regression_preconditions);
 
+    /*
+      Build the flat representation and free the pointer-based tree. Must be
+      called after the last insert.
+    */
+    void finalize();
+
     /*
       Extracts all IDs of applicable abstract operators for the abstract state
       given by state_index (the index is converted back to variable/values
@@ -48,6 +79,7 @@ public:
     */
     void get_applicable_operator_ids(
         size_t state_index, std::vector<int> &operator_ids) const;
+    // Must be called after finalize.
     void dump() const;
 };
 }
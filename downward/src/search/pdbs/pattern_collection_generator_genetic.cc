@@ -12,6 +12,7 @@
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/math.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../utils/timer.h"
@@ -32,6 +33,7 @@ PatternCollectionGeneratorGenetic::PatternCollectionGeneratorGenetic(
       num_episodes(opts.get<int>("num_episodes")),
       mutation_probability(opts.get<double>("mutation_probability")),
       disjoint_patterns(opts.get<bool>("disjoint")),
+      num_threads(opts.get<int>("threads")),
       rng(utils::parse_rng_from_options(opts)) {
 }
 
@@ -196,7 +198,8 @@ void PatternCollectionGeneratorGenetic::evaluate(vector<double> &fitness_values)
         } else {
             /* Generate the pattern collection heuristic and get its fitness
                value. */
-            ZeroOnePDBs zero_one_pdbs(task_proxy, *pattern_collection);
+            ZeroOnePDBs zero_one_pdbs(
+                task_proxy, *pattern_collection, num_threads, pdb_max_size);
             fitness = zero_one_pdbs.compute_approx_mean_finite_h();
             // Update the best heuristic found so far.
             if (fitness > best_fitness) {
@@ -282,7 +285,7 @@ PatternCollectionInformation PatternCollectionGeneratorGenetic::generate(
 
     TaskProxy task_proxy(*task);
     assert(best_patterns);
-    PatternCollectionInformation pci(task_proxy, best_patterns);
+    PatternCollectionInformation pci(task_proxy, best_patterns, num_threads);
     dump_pattern_collection_generation_statistics(
         "Genetic generator", timer(), pci);
     return pci;
@@ -371,6 +374,11 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "consider a pattern collection invalid (giving it very low "
         "fitness) if its patterns are not disjoint",
         "false");
+    utils::add_threads_option_to_parser(
+        parser,
+        "number of threads for computing the PDBs of the pattern "
+        "collections of each generation (the resulting pattern collection "
+        "does not depend on this number)");
 
     utils::add_rng_options(parser);
 
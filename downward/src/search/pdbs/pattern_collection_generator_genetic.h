@@ -33,6 +33,8 @@ class PatternCollectionGeneratorGenetic : public PatternCollectionGenerator {
     /* Specifies whether patterns in each pattern collection need to be disjoint
        or not. */
     const bool disjoint_patterns;
+    // number of threads for building the PDBs of a collection
+    const int num_threads;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
 
     std::shared_ptr<AbstractTask> task;
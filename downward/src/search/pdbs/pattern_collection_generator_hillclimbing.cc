@@ -18,11 +18,13 @@
 #include "../utils/markup.h"
 #include "../utils/math.h"
 #include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <limits>
@@ -118,20 +120,20 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(c
       num_samples(opts.get<int>("num_samples")),
       min_improvement(opts.get<int>("min_improvement")),
       max_time(opts.get<double>("max_time")),
+      num_threads(opts.get<int>("threads")),
       rng(utils::parse_rng_from_options(opts)),
       num_rejected(0),
       hill_climbing_timer(0) {
 }
 
-int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
+void PatternCollectionGeneratorHillclimbing::generate_candidate_patterns(
     const TaskProxy &task_proxy,
     const vector<vector<int>> &relevant_neighbours,
     const PatternDatabase &pdb,
     set<Pattern> &generated_patterns,
-    PDBCollection &candidate_pdbs) {
+    PatternCollection &candidate_patterns) {
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
-    int max_pdb_size = 0;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -152,22 +154,27 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                 new_pattern.push_back(rel_var_id);
                 sort(new_pattern.begin(), new_pattern.end());
                 if (!generated_patterns.count(new_pattern)) {
-                    /*
-                      If we haven't seen this pattern before, generate a PDB
-                      for it and add it to candidate_pdbs if its size does not
-                      surpass the size limit.
-                    */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        make_shared<PatternDatabase>(task_proxy, new_pattern));
-                    max_pdb_size = max(max_pdb_size,
-                                       candidate_pdbs.back()->get_size());
+                    candidate_patterns.push_back(new_pattern);
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+}
+
+int PatternCollectionGeneratorHillclimbing::compute_candidate_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &candidate_patterns,
+    PDBCollection &candidate_pdbs) {
+    PDBCollection new_pdbs = compute_pdbs(
+        task_proxy, candidate_patterns, num_threads, pdb_max_size);
+    int max_pdb_size = 0;
+    for (shared_ptr<PatternDatabase> &pdb : new_pdbs) {
+        max_pdb_size = max(max_pdb_size, pdb->get_size());
+        candidate_pdbs.push_back(move(pdb));
+    }
     return max_pdb_size;
 }
 
@@ -190,10 +197,89 @@ void PatternCollectionGeneratorHillclimbing::sample_states(
     }
 }
 
+void PatternCollectionGeneratorHillclimbing::compute_sample_values(
+    const vector<State> &samples,
+    vector<vector<int>> &samples_pdb_values,
+    vector<int> &samples_h_values) const {
+    // Unpack the samples here because unpacking is not thread-safe.
+    for (const State &sample : samples) {
+        sample.unpack();
+    }
+    const PDBCollection &pdbs = *current_pdbs->get_pattern_databases();
+    int num_pdbs = pdbs.size();
+    samples_pdb_values.resize(num_samples);
+    samples_h_values.resize(num_samples);
+    utils::parallel_for(
+        num_samples, num_threads,
+        [&](int sample_id, int) {
+            const State &sample = samples[sample_id];
+            vector<int> &pdb_values = samples_pdb_values[sample_id];
+            pdb_values.resize(num_pdbs);
+            for (int i = 0; i < num_pdbs; ++i) {
+                pdb_values[i] = pdbs[i]->get_value(sample.get_unpacked_values());
+            }
+            samples_h_values[sample_id] = current_pdbs->get_value(sample);
+        });
+}
+
 pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
     const vector<State> &samples,
+    const vector<vector<int>> &samples_pdb_values,
     const vector<int> &samples_h_values,
     PDBCollection &candidate_pdbs) {
+    /*
+      If a candidate's size added to the current collection's size exceeds
+      the maximum collection size, then forget the pdb.
+    */
+    for (shared_ptr<PatternDatabase> &pdb : candidate_pdbs) {
+        if (pdb && current_pdbs->get_size() + pdb->get_size() > collection_max_size) {
+            pdb = nullptr;
+        }
+    }
+
+    /*
+      Calculate the "counting approximation" for all candidates and sample
+      states: count the number of samples for which the current pattern
+      collection heuristic would be improved if the new pattern was
+      included into it.
+    */
+    /*
+      TODO: The original implementation by Haslum et al. uses m/t as a
+      statistical confidence interval to stop the A*-search (which they use,
+      see above) earlier.
+    */
+    int num_candidates = candidate_pdbs.size();
+    vector<int> counts(num_candidates, 0);
+    atomic<bool> timeout(false);
+    utils::parallel_for(
+        num_candidates, num_threads,
+        [&](int i, int) {
+            const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
+            if (!pdb || timeout) {
+                /* candidate pattern is too large or has already been added to
+                   the canonical heuristic. */
+                return;
+            }
+            if (hill_climbing_timer->is_expired()) {
+                timeout = true;
+                return;
+            }
+            vector<PatternClique> pattern_cliques =
+                current_pdbs->get_pattern_cliques(pdb->get_pattern());
+            int count = 0;
+            for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
+                assert(utils::in_bounds(sample_id, samples_h_values));
+                if (is_heuristic_improved(
+                        *pdb, samples[sample_id], samples_h_values[sample_id],
+                        samples_pdb_values[sample_id], pattern_cliques)) {
+                    ++count;
+                }
+            }
+            counts[i] = count;
+        });
+    if (timeout)
+        throw HillClimbingTimeout();
+
     /*
       TODO: The original implementation by Haslum et al. uses A* to compute
       h values for the sample states only instead of generating all PDBs.
@@ -203,51 +289,8 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
     */
     int improvement = 0;
     int best_pdb_index = -1;
-
-    // Iterate over all candidates and search for the best improving pattern/pdb
-    for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
-        if (hill_climbing_timer->is_expired())
-            throw HillClimbingTimeout();
-
-        const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
-        if (!pdb) {
-            /* candidate pattern is too large or has already been added to
-               the canonical heuristic. */
-            continue;
-        }
-        /*
-          If a candidate's size added to the current collection's size exceeds
-          the maximum collection size, then forget the pdb.
-        */
-        int combined_size = current_pdbs->get_size() + pdb->get_size();
-        if (combined_size > collection_max_size) {
-            candidate_pdbs[i] = nullptr;
-            continue;
-        }
-
-        /*
-          Calculate the "counting approximation" for all sample states: count
-          the number of samples for which the current pattern collection
-          heuristic would be improved if the new pattern was included into it.
-        */
-        /*
-          TODO: The original implementation by Haslum et al. uses m/t as a
-          statistical confidence interval to stop the A*-search (which they use,
-          see above) earlier.
-        */
-        int count = 0;
-        vector<PatternClique> pattern_cliques =
-            current_pdbs->get_pattern_cliques(pdb->get_pattern());
-        for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
-            const State &sample = samples[sample_id];
-            assert(utils::in_bounds(sample_id, samples_h_values));
-            int h_collection = samples_h_values[sample_id];
-            if (is_heuristic_improved(
-                    *pdb, sample, h_collection,
-                    *current_pdbs->get_pattern_databases(), pattern_cliques)) {
-                ++count;
-            }
-        }
+    for (int i = 0; i < num_candidates; ++i) {
+        int count = counts[i];
         if (count > improvement) {
             improvement = count;
             best_pdb_index = i;
@@ -263,7 +306,8 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
 
 bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
     const PatternDatabase &pdb, const State &sample, int h_collection,
-    const PDBCollection &pdbs, const vector<PatternClique> &pattern_cliques) {
+    const vector<int> &pdb_values,
+    const vector<PatternClique> &pattern_cliques) const {
     const vector<int> &sample_data = sample.get_unpacked_values();
     // h_pattern: h-value of the new pattern
     int h_pattern = pdb.get_value(sample_data);
@@ -276,18 +320,10 @@ bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
     if (h_collection == numeric_limits<int>::max())
         return false;
 
-    vector<int> h_values;
-    h_values.reserve(pdbs.size());
-    for (const shared_ptr<PatternDatabase> &p : pdbs) {
-        int h = p->get_value(sample_data);
-        if (h == numeric_limits<int>::max())
-            return false;
-        h_values.push_back(h);
-    }
     for (const PatternClique &clilque : pattern_cliques) {
         int h_clique = 0;
         for (PatternID pattern_id : clilque) {
-            h_clique += h_values[pattern_id];
+            h_clique += pdb_values[pattern_id];
         }
         if (h_pattern + h_clique > h_collection) {
             /*
@@ -302,7 +338,7 @@ bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
 
 void PatternCollectionGeneratorHillclimbing::hill_climbing(
     const TaskProxy &task_proxy) {
-    hill_climbing_timer = new utils::CountdownTimer(max_time);
+    hill_climbing_timer = new utils::WallClockCountdownTimer(max_time);
 
     utils::g_log << "Average operator cost: "
                  << task_properties::get_average_operator_cost(task_proxy) << endl;
@@ -315,15 +351,16 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
     // The PDBs for the patterns in generated_patterns that satisfy the size
     // limit to avoid recomputation.
     PDBCollection candidate_pdbs;
-    // The maximum size over all PDBs in candidate_pdbs.
-    int max_pdb_size = 0;
+    PatternCollection candidate_patterns;
     for (const shared_ptr<PatternDatabase> &current_pdb :
          *(current_pdbs->get_pattern_databases())) {
-        int new_max_pdb_size = generate_candidate_pdbs(
+        generate_candidate_patterns(
             task_proxy, relevant_neighbours, *current_pdb, generated_patterns,
-            candidate_pdbs);
-        max_pdb_size = max(max_pdb_size, new_max_pdb_size);
+            candidate_patterns);
     }
+    // The maximum size over all PDBs in candidate_pdbs.
+    int max_pdb_size = compute_candidate_pdbs(
+        task_proxy, candidate_patterns, candidate_pdbs);
     /*
       NOTE: The initial set of candidate patterns (in generated_patterns) is
       guaranteed to be "normalized" in the sense that there are no duplicates
@@ -336,6 +373,8 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
 
     sampling::RandomWalkSampler sampler(task_proxy, *rng);
     vector<State> samples;
+    // h-values of the PDBs in the current collection for each sample
+    vector<vector<int>> samples_pdb_values;
     vector<int> samples_h_values;
 
     try {
@@ -353,14 +392,12 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
             }
 
             samples.clear();
-            samples_h_values.clear();
             sample_states(sampler, init_h, samples);
-            for (const State &sample : samples) {
-                samples_h_values.push_back(current_pdbs->get_value(sample));
-            }
+            compute_sample_values(samples, samples_pdb_values, samples_h_values);
 
             pair<int, int> improvement_and_index =
-                find_best_improving_pdb(samples, samples_h_values, candidate_pdbs);
+                find_best_improving_pdb(
+                    samples, samples_pdb_values, samples_h_values, candidate_pdbs);
             int improvement = improvement_and_index.first;
             int best_pdb_index = improvement_and_index.second;
 
@@ -381,9 +418,12 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
             current_pdbs->add_pdb(best_pdb);
 
             // Generate candidate patterns and PDBs for next iteration.
-            int new_max_pdb_size = generate_candidate_pdbs(
+            candidate_patterns.clear();
+            generate_candidate_patterns(
                 task_proxy, relevant_neighbours, *best_pdb, generated_patterns,
-                candidate_pdbs);
+                candidate_patterns);
+            int new_max_pdb_size = compute_candidate_pdbs(
+                task_proxy, candidate_patterns, candidate_pdbs);
             max_pdb_size = max(max_pdb_size, new_max_pdb_size);
 
             // Remove the added PDB from candidate_pdbs.
@@ -465,9 +505,17 @@ void add_hillclimbing_options(OptionParser &parser) {
         "collection via hill climbing. If set to 0, no hill climbing "
         "is performed at all. Note that this limit only affects hill "
         "climbing. Use max_time_dominance_pruning to limit the time "
-        "spent for pruning dominated patterns.",
+        "spent for pruning dominated patterns. The limit applies to "
+        "wall-clock time, so with more threads hill climbing can do "
+        "more work within it.",
         "infinity",
         Bounds("0.0", "infinity"));
+    utils::add_threads_option_to_parser(
+        parser,
+        "number of threads for computing the PDBs of candidate patterns "
+        "and for evaluating the candidates on the samples (the resulting "
+        "pattern collection does not depend on this number unless "
+        "max_time is reached)");
     utils::add_rng_options(parser);
 }
 
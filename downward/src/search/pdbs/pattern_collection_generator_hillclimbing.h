@@ -16,8 +16,8 @@ class Options;
 }
 
 namespace utils {
-class CountdownTimer;
 class RandomNumberGenerator;
+class WallClockCountdownTimer;
 }
 
 namespace sampling {
@@ -39,28 +39,38 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     // minimal improvement required for hill climbing to continue search
     const int min_improvement;
     const double max_time;
+    // number of threads for building candidate PDBs
+    const int num_threads;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
 
     std::unique_ptr<IncrementalCanonicalPDBs> current_pdbs;
 
     // for stats only
     int num_rejected;
-    utils::CountdownTimer *hill_climbing_timer;
+    utils::WallClockCountdownTimer *hill_climbing_timer;
 
     /*
       For the given PDB, all possible extensions of its pattern by one
       relevant variable are considered as candidate patterns. If the candidate
       pattern has not been previously considered (not contained in
       generated_patterns) and if building a PDB for it does not surpass the
-      size limit, then the PDB is built and added to candidate_pdbs.
-
-      The method returns the size of the largest PDB added to candidate_pdbs.
+      size limit, then it is added to candidate_patterns.
     */
-    int generate_candidate_pdbs(
+    void generate_candidate_patterns(
         const TaskProxy &task_proxy,
         const std::vector<std::vector<int>> &relevant_neighbours,
         const PatternDatabase &pdb,
         std::set<Pattern> &generated_patterns,
+        PatternCollection &candidate_patterns);
+
+    /*
+      Builds the PDBs for the given candidate patterns (in parallel if
+      num_threads > 1) and appends them to candidate_pdbs in the order of
+      the patterns. The method returns the size of the largest new PDB.
+    */
+    int compute_candidate_pdbs(
+        const TaskProxy &task_proxy,
+        const PatternCollection &candidate_patterns,
         PDBCollection &candidate_pdbs);
 
     /*
@@ -78,13 +88,29 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
         int init_h,
         std::vector<State> &samples);
 
+    /*
+      Computes the h-values of all PDBs of the current collection and the
+      h-value of the current collection for the given samples.
+    */
+    void compute_sample_values(
+        const std::vector<State> &samples,
+        std::vector<std::vector<int>> &samples_pdb_values,
+        std::vector<int> &samples_h_values) const;
+
     /*
       Searches for the best improving pdb in candidate_pdbs according to the
       counting approximation and the given samples. Returns the improvement and
-      the index of the best pdb in candidate_pdbs.
+      the index of the best pdb in candidate_pdbs. The candidates are evaluated
+      in parallel if num_threads > 1, with the same result as in a serial run
+      unless the time limit expires during the evaluation.
+
+      samples_pdb_values[i] contains the h-values of all PDBs of the current
+      collection for samples[i] and samples_h_values[i] the h-value of the
+      current collection.
     */
     std::pair<int, int> find_best_improving_pdb(
         const std::vector<State> &samples,
+        const std::vector<std::vector<int>> &samples_pdb_values,
         const std::vector<int> &samples_h_values,
         PDBCollection &candidate_pdbs);
 
@@ -92,20 +118,21 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
       Returns true iff the h-value of the new pattern (from pdb) plus the
       h-value of all pattern cliques from the current pattern
       collection heuristic if the new pattern was added to it is greater than
-      the h-value of the current pattern collection.
+      the h-value of the current pattern collection. pdb_values contains the
+      h-values of the PDBs of the current collection for the sample.
     */
     bool is_heuristic_improved(
         const PatternDatabase &pdb,
         const State &sample,
         int h_collection,
-        const PDBCollection &pdbs,
-        const std::vector<PatternClique> &pattern_cliques);
+        const std::vector<int> &pdb_values,
+        const std::vector<PatternClique> &pattern_cliques) const;
 
     /*
       This is the core algorithm of this class. The initial PDB collection
       consists of one PDB for each goal variable. For each PDB of this initial
       collection, the set of candidate PDBs are added (see
-      generate_candidate_pdbs) to the set of initial candidate PDBs.
+      generate_candidate_patterns) to the set of initial candidate PDBs.
 
       The main loop of the search computes a set of sample states (see
       sample_states) and uses this set to evaluate the set of all candidate PDBs
@@ -113,7 +140,7 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
       improvement obtained through adding the best PDB to the current heuristic
       is smaller than the minimal required improvement, the search is stopped.
       Otherwise, the best PDB is added to the heuristic and the candidate PDBs
-      for this best PDB are computed (see generate_candidate_pdbs) and used for
+      for this best PDB are computed (see generate_candidate_patterns) and used for
       the next iteration.
 
       This method uses a set to store all patterns that are generated as
@@ -10,6 +10,7 @@
 #include "../task_utils/causal_graph.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -50,7 +51,8 @@ static void compute_union_pattern(
 PatternCollectionGeneratorSystematic::PatternCollectionGeneratorSystematic(
     const Options &opts)
     : max_pattern_size(opts.get<int>("pattern_max_size")),
-      only_interesting_patterns(opts.get<bool>("only_interesting_patterns")) {
+      only_interesting_patterns(opts.get<bool>("only_interesting_patterns")),
+      num_threads(opts.get<int>("threads")) {
 }
 
 void PatternCollectionGeneratorSystematic::compute_eff_pre_neighbors(
@@ -273,7 +275,7 @@ PatternCollectionInformation PatternCollectionGeneratorSystematic::generate(
     } else {
         build_patterns_naive(task_proxy);
     }
-    PatternCollectionInformation pci(task_proxy, patterns);
+    PatternCollectionInformation pci(task_proxy, patterns, num_threads);
     /* Do not dump the collection since it can be very large for
        pattern_max_size >= 3. */
     dump_pattern_collection_generation_statistics(
@@ -306,6 +308,10 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "Only consider the union of two disjoint patterns if the union has "
         "more information than the individual patterns.",
         "true");
+    utils::add_threads_option_to_parser(
+        parser,
+        "number of threads for computing the PDBs of the generated "
+        "patterns (the PDBs do not depend on this number)");
 
     Options opts = parser.parse();
     if (parser.dry_run())
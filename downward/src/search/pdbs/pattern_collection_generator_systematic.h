@@ -30,6 +30,8 @@ class PatternCollectionGeneratorSystematic : public PatternCollectionGenerator {
 
     const size_t max_pattern_size;
     const bool only_interesting_patterns;
+    // number of threads for computing the PDBs of the collection
+    const int num_threads;
     std::shared_ptr<PatternCollection> patterns;
     PatternSet pattern_set;  // Cleared after pattern computation.
 
@@ -2,6 +2,7 @@
 
 #include "pattern_database.h"
 #include "pattern_cliques.h"
+#include "utils.h"
 #include "validation.h"
 
 #include "../utils/logging.h"
@@ -17,11 +18,13 @@ using namespace std;
 namespace pdbs {
 PatternCollectionInformation::PatternCollectionInformation(
     const TaskProxy &task_proxy,
-    const shared_ptr<PatternCollection> &patterns)
+    const shared_ptr<PatternCollection> &patterns,
+    int num_threads)
     : task_proxy(task_proxy),
       patterns(patterns),
       pdbs(nullptr),
-      pattern_cliques(nullptr) {
+      pattern_cliques(nullptr),
+      num_threads(num_threads) {
     assert(patterns);
     validate_and_normalize_patterns(task_proxy, *patterns);
 }
@@ -58,12 +61,8 @@ void PatternCollectionInformation::create_pdbs_if_missing() {
     if (!pdbs) {
         utils::Timer timer;
         utils::g_log << "Computing PDBs for pattern collection..." << endl;
-        pdbs = make_shared<PDBCollection>();
-        for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
-                make_shared<PatternDatabase>(task_proxy, pattern);
-            pdbs->push_back(pdb);
-        }
+        pdbs = make_shared<PDBCollection>(
+            compute_pdbs(task_proxy, *patterns, num_threads));
         utils::g_log << "Done computing PDBs for pattern collection: " << timer << endl;
     }
 }
@@ -25,6 +25,8 @@ class PatternCollectionInformation {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
+    // number of threads for computing missing PDBs
+    int num_threads;
 
     void create_pdbs_if_missing();
     void create_pattern_cliques_if_missing();
@@ -33,7 +35,8 @@ class PatternCollectionInformation {
 public:
     PatternCollectionInformation(
         const TaskProxy &task_proxy,
-        const std::shared_ptr<PatternCollection> &patterns);
+        const std::shared_ptr<PatternCollection> &patterns,
+        int num_threads = 1);
     ~PatternCollectionInformation() = default;
 
     void set_pdbs(const std::shared_ptr<PDBCollection> &pdbs);
@@ -214,6 +214,7 @@ void PatternDatabase::create_pdb(
         const AbstractOperator &op = operators[op_id];
         match_tree.insert(op_id, op.get_regression_preconditions());
     }
+    match_tree.finalize();
 
     // compute abstract goal var-val pairs
     vector<FactPair> abstract_goals;
@@ -225,7 +226,8 @@ void PatternDatabase::create_pdb(
         }
     }
 
-    distances.reserve(num_states);
+    vector<int> abstract_distances;
+    abstract_distances.reserve(num_states);
     // first implicit entry: priority, second entry: index for an abstract state
     priority_queues::AdaptiveQueue<size_t> pq;
 
@@ -233,34 +235,64 @@ void PatternDatabase::create_pdb(
     for (size_t state_index = 0; state_index < num_states; ++state_index) {
         if (is_goal_state(state_index, abstract_goals, variables)) {
             pq.push(0, state_index);
-            distances.push_back(0);
+            abstract_distances.push_back(0);
         } else {
-            distances.push_back(numeric_limits<int>::max());
+            abstract_distances.push_back(numeric_limits<int>::max());
         }
     }
 
     // Dijkstra loop
+    vector<int> applicable_operator_ids;
     while (!pq.empty()) {
         pair<int, size_t> node = pq.pop();
         int distance = node.first;
         size_t state_index = node.second;
-        if (distance > distances[state_index]) {
+        if (distance > abstract_distances[state_index]) {
             continue;
         }
 
         // regress abstract_state
-        vector<int> applicable_operator_ids;
+        applicable_operator_ids.clear();
         match_tree.get_applicable_operator_ids(state_index, applicable_operator_ids);
         for (int op_id : applicable_operator_ids) {
             const AbstractOperator &op = operators[op_id];
             size_t predecessor = state_index + op.get_hash_effect();
-            int alternative_cost = distances[state_index] + op.get_cost();
-            if (alternative_cost < distances[predecessor]) {
-                distances[predecessor] = alternative_cost;
+            int alternative_cost = abstract_distances[state_index] + op.get_cost();
+            if (alternative_cost < abstract_distances[predecessor]) {
+                abstract_distances[predecessor] = alternative_cost;
                 pq.push(alternative_cost, predecessor);
             }
         }
     }
+    store_distances(abstract_distances);
+}
+
+void PatternDatabase::store_distances(const vector<int> &h_values) {
+    int max_h = 0;
+    for (int h : h_values) {
+        if (h != numeric_limits<int>::max())
+            max_h = max(max_h, h);
+    }
+    // The largest value of each width is reserved for dead ends.
+    entry_bits_shift = 2;
+    while ((static_cast<uint64_t>(1) << (1 << entry_bits_shift)) - 1 <=
+           static_cast<uint64_t>(max_h)) {
+        ++entry_bits_shift;
+    }
+    assert(entry_bits_shift <= 5);
+    int bits_per_entry = 1 << entry_bits_shift;
+    entries_per_word_shift = 6 - entry_bits_shift;
+    entry_mask = (static_cast<uint64_t>(1) << bits_per_entry) - 1;
+
+    size_t entries_per_word = static_cast<size_t>(1) << entries_per_word_shift;
+    distances.assign((h_values.size() + entries_per_word - 1) / entries_per_word, 0);
+    for (size_t index = 0; index < h_values.size(); ++index) {
+        int h = h_values[index];
+        uint64_t entry = (h == numeric_limits<int>::max()) ? entry_mask : h;
+        int shift = static_cast<int>(
+            (index & (entries_per_word - 1)) << entry_bits_shift);
+        distances[index >> entries_per_word_shift] |= entry << shift;
+    }
 }
 
 bool PatternDatabase::is_goal_state(
@@ -289,15 +321,16 @@ size_t PatternDatabase::hash_index(const vector<int> &state) const {
 }
 
 int PatternDatabase::get_value(const vector<int> &state) const {
-    return distances[hash_index(state)];
+    return get_distance(hash_index(state));
 }
 
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
-    for (size_t i = 0; i < distances.size(); ++i) {
-        if (distances[i] != numeric_limits<int>::max()) {
-            sum += distances[i];
+    for (size_t i = 0; i < num_states; ++i) {
+        int h = get_distance(i);
+        if (h != numeric_limits<int>::max()) {
+            sum += h;
             ++size;
         }
     }
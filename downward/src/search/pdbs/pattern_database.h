@@ -5,6 +5,8 @@
 
 #include "../task_proxy.h"
 
+#include <cstdint>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -77,10 +79,17 @@ class PatternDatabase {
     std::size_t num_states;
 
     /*
-      final h-values for abstract-states.
-      dead-ends are represented by numeric_limits<int>::max()
+      final h-values for abstract-states, packed into 64-bit words with
+      4, 8, 16 or 32 bits per entry. We use the smallest width that can
+      represent the maximal finite h-value. Dead-ends are represented by
+      the largest value of the width (all bits set).
     */
-    std::vector<int> distances;
+    std::vector<std::uint64_t> distances;
+    // log2 of the number of bits per entry
+    int entry_bits_shift;
+    // log2 of the number of entries per word
+    int entries_per_word_shift;
+    std::uint64_t entry_mask;
 
     // multipliers for each variable for perfect hash function
     std::vector<std::size_t> hash_multipliers;
@@ -141,6 +150,9 @@ class PatternDatabase {
       (distances) during search.
     */
     std::size_t hash_index(const std::vector<int> &state) const;
+
+    // Chooses the entry width for the given h-values and stores them.
+    void store_distances(const std::vector<int> &h_values);
 public:
     /*
       Important: It is assumed that the pattern (passed via Options) is
@@ -161,6 +173,25 @@ public:
 
     int get_value(const std::vector<int> &state) const;
 
+    // Returns the h-value of the abstract state with the given index.
+    int get_distance(std::size_t index) const {
+        std::uint64_t word = distances[index >> entries_per_word_shift];
+        int shift = static_cast<int>(
+            (index & ((1 << entries_per_word_shift) - 1)) << entry_bits_shift);
+        std::uint64_t entry = (word >> shift) & entry_mask;
+        return entry == entry_mask ? std::numeric_limits<int>::max()
+               : static_cast<int>(entry);
+    }
+
+    /*
+      Returns the multipliers of the perfect hash function: the index of
+      an abstract state is the sum of hash_multipliers[i] times the value
+      of pattern[i].
+    */
+    const std::vector<std::size_t> &get_hash_multipliers() const {
+        return hash_multipliers;
+    }
+
     // Returns the pattern (i.e. all variables used) of the PDB
     const Pattern &get_pattern() const {
         return pattern;
@@ -4,9 +4,14 @@
 #include "pattern_database.h"
 #include "pattern_information.h"
 
+#include "../task_proxy.h"
+
 #include "../utils/logging.h"
+#include "../utils/parallel.h"
 
-#include "../task_proxy.h"
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
 
 using namespace std;
 
@@ -28,6 +33,44 @@ int compute_total_pdb_size(
     return size;
 }
 
+PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    int num_threads,
+    int max_concurrent_size,
+    const vector<vector<int>> &operator_costs) {
+    assert(operator_costs.empty() || operator_costs.size() == patterns.size());
+    int num_patterns = patterns.size();
+    PDBCollection pdbs(num_patterns);
+    const vector<int> no_operator_costs;
+    mutex size_mutex;
+    condition_variable size_released;
+    int concurrent_size = 0;
+    utils::parallel_for(
+        num_patterns, num_threads,
+        [&](int i, int) {
+            int size = compute_pdb_size(task_proxy, patterns[i]);
+            {
+                unique_lock<mutex> lock(size_mutex);
+                while (concurrent_size > 0 &&
+                       size > max_concurrent_size - concurrent_size) {
+                    size_released.wait(lock);
+                }
+                concurrent_size += size;
+            }
+            const vector<int> &costs = operator_costs.empty() ?
+                no_operator_costs : operator_costs[i];
+            pdbs[i] = make_shared<PatternDatabase>(
+                task_proxy, patterns[i], false, costs);
+            {
+                lock_guard<mutex> lock(size_mutex);
+                concurrent_size -= size;
+            }
+            size_released.notify_all();
+        });
+    return pdbs;
+}
+
 void dump_pattern_generation_statistics(
     const string &identifier,
     utils::Duration runtime,
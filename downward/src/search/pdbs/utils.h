@@ -5,8 +5,10 @@
 
 #include "../utils/timer.h"
 
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 class TaskProxy;
 
@@ -18,6 +20,23 @@ extern int compute_pdb_size(const TaskProxy &task_proxy, const Pattern &pattern)
 extern int compute_total_pdb_size(
     const TaskProxy &task_proxy, const PatternCollection &pattern_collection);
 
+/*
+  Compute the PDBs for the given patterns with num_threads threads and
+  return them in the order of the patterns. If operator_costs is not
+  empty, operator_costs[i] are the operator costs used for patterns[i].
+
+  To bound the memory usage, a PDB is only built while the total size of
+  the PDBs under construction stays within max_concurrent_size. A PDB
+  that exceeds this limit on its own is built while no other PDB is
+  under construction.
+*/
+extern PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    int num_threads,
+    int max_concurrent_size = std::numeric_limits<int>::max(),
+    const std::vector<std::vector<int>> &operator_costs = {});
+
 /*
   Dump the given pattern, the number of variables contained, the size of the
   corresponding PDB, and the runtime used for computing it. All output is
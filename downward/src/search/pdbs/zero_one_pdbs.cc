@@ -1,11 +1,13 @@
 #include "zero_one_pdbs.h"
 
 #include "pattern_database.h"
+#include "utils.h"
 
 #include "../task_proxy.h"
 
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -15,27 +17,39 @@ using namespace std;
 
 namespace pdbs {
 ZeroOnePDBs::ZeroOnePDBs(
-    const TaskProxy &task_proxy, const PatternCollection &patterns) {
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    int num_threads, int max_concurrent_size) {
     vector<int> remaining_operator_costs;
     OperatorsProxy operators = task_proxy.get_operators();
     remaining_operator_costs.reserve(operators.size());
     for (OperatorProxy op : operators)
         remaining_operator_costs.push_back(op.get_cost());
 
-    pattern_databases.reserve(patterns.size());
+    /*
+      The costs for a pattern only depend on which operators are relevant
+      for the previous patterns, so we can compute all cost functions
+      upfront and build the PDBs independently of each other.
+    */
+    vector<vector<int>> operator_costs;
+    operator_costs.reserve(patterns.size());
     for (const Pattern &pattern : patterns) {
-        shared_ptr<PatternDatabase> pdb = make_shared<PatternDatabase>(
-            task_proxy, pattern, false, remaining_operator_costs);
+        operator_costs.push_back(remaining_operator_costs);
 
         /* Set cost of relevant operators to 0 for further iterations
            (action cost partitioning). */
         for (OperatorProxy op : operators) {
-            if (pdb->is_operator_relevant(op))
-                remaining_operator_costs[op.get_id()] = 0;
+            for (EffectProxy effect : op.get_effects()) {
+                int var_id = effect.get_fact().get_variable().get_id();
+                if (binary_search(pattern.begin(), pattern.end(), var_id)) {
+                    remaining_operator_costs[op.get_id()] = 0;
+                    break;
+                }
+            }
         }
-
-        pattern_databases.push_back(pdb);
     }
+
+    pattern_databases = compute_pdbs(
+        task_proxy, patterns, num_threads, max_concurrent_size, operator_costs);
 }
 
 
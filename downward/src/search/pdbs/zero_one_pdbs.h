@@ -3,6 +3,8 @@
 
 #include "types.h"
 
+#include <limits>
+
 class State;
 class TaskProxy;
 
@@ -10,7 +12,13 @@ namespace pdbs {
 class ZeroOnePDBs {
     PDBCollection pattern_databases;
 public:
-    ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns);
+    /*
+      The PDBs are built with num_threads threads, see compute_pdbs for
+      the meaning of max_concurrent_size.
+    */
+    ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns,
+                int num_threads = 1,
+                int max_concurrent_size = std::numeric_limits<int>::max());
     ~ZeroOnePDBs() = default;
 
     int get_value(const State &state) const;
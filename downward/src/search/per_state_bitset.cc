@@ -1,5 +1,11 @@
 #include "per_state_bitset.h"
 
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 using namespace std;
 
 
@@ -55,6 +61,34 @@ void BitsetView::intersect(const BitsetView &other) {
     }
 }
 
+static int get_lowest_bit_index(BitsetMath::Block block) {
+    static_assert(
+        sizeof(BitsetMath::Block) == sizeof(unsigned int),
+        "count-trailing-zeros intrinsic expects unsigned int blocks");
+    assert(block != 0);
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, block);
+    return index;
+#else
+    return __builtin_ctz(block);
+#endif
+}
+
+void BitsetView::collect_bits_not_in(
+    const BitsetView &other, vector<int> &bits) const {
+    assert(num_bits == other.num_bits);
+    for (int i = 0; i < data.size(); ++i) {
+        BitsetMath::Block block = data[i] & ~other.data[i];
+        int block_offset = i * BitsetMath::bits_per_block;
+        while (block) {
+            bits.push_back(block_offset + get_lowest_bit_index(block));
+            // Clear the lowest set bit.
+            block &= block - 1;
+        }
+    }
+}
+
 int BitsetView::size() const {
     return num_bits;
 }
@@ -79,6 +113,26 @@ PerStateBitset::PerStateBitset(const vector<bool> &default_bits)
       data(pack_bit_vector(default_bits)) {
 }
 
+static vector<BitsetMath::Block> get_default_blocks(
+    int num_bits, bool default_value) {
+    int num_blocks = BitsetMath::compute_num_blocks(num_bits);
+    vector<BitsetMath::Block> blocks(num_blocks, BitsetMath::Block(0));
+    if (default_value && num_blocks > 0) {
+        fill(blocks.begin(), blocks.end(), BitsetMath::Block(BitsetMath::ones));
+        // Keep the unused bits of the last block unset.
+        int num_used_bits = num_bits - (num_blocks - 1) * BitsetMath::bits_per_block;
+        if (num_used_bits < BitsetMath::bits_per_block) {
+            blocks.back() = (BitsetMath::Block(1) << num_used_bits) - 1;
+        }
+    }
+    return blocks;
+}
+
+PerStateBitset::PerStateBitset(int num_bits, bool default_value)
+    : num_bits_per_entry(num_bits),
+      data(get_default_blocks(num_bits, default_value)) {
+}
+
 BitsetView PerStateBitset::operator[](const State &state) {
     return BitsetView(data[state], num_bits_per_entry);
 }
@@ -39,6 +39,9 @@ public:
     void reset();
     bool test(int index) const;
     void intersect(const BitsetView &other);
+    // Append the indices of the bits set here but not in other to bits.
+    void collect_bits_not_in(
+        const BitsetView &other, std::vector<int> &bits) const;
     int size() const;
 };
 
@@ -48,6 +51,7 @@ class PerStateBitset {
     PerStateArray<BitsetMath::Block> data;
 public:
     explicit PerStateBitset(const std::vector<bool> &default_bits);
+    PerStateBitset(int num_bits, bool default_value);
 
     PerStateBitset(const PerStateBitset &) = delete;
     PerStateBitset &operator=(const PerStateBitset &) = delete;
@@ -3,6 +3,7 @@
 
 #include "state_registry.h"
 
+#include "algorithms/mapped_segment_pool.h"
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
 #include "utils/collections.h"
@@ -31,6 +32,11 @@
   remember (in "cached_registry" and "cached_entries") the results of the
   previous lookup and reuse it on consecutive lookups for the same registry.
 
+  If use_segment_pool is set, the SegmentedVectors take their memory from the
+  MappedSegmentPool of the registry (if it has one), i.e., the information is
+  stored in a file mapped into memory. This is meant for information that is
+  stored for all registered states, such as the search node infos.
+
   A PerStateInformation object subscribes to every StateRegistry for which it
   stores information. Once a StateRegistry is destroyed, it notifies all
   subscribed objects, which in turn destroy all information stored for states
@@ -38,13 +44,16 @@
 */
 template<class Entry>
 class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
+    using EntryVector = segmented_vector::SegmentedVector<
+        Entry, segmented_vector::SegmentAllocator<Entry>>;
     const Entry default_value;
+    const bool use_segment_pool;
     using EntryVectorMap = std::unordered_map<const StateRegistry *,
-                                              segmented_vector::SegmentedVector<Entry> * >;
+                                              EntryVector *>;
     EntryVectorMap entries_by_registry;
 
     mutable const StateRegistry *cached_registry;
-    mutable segmented_vector::SegmentedVector<Entry> *cached_entries;
+    mutable EntryVector *cached_entries;
 
     /*
       Returns the SegmentedVector associated with the given StateRegistry.
@@ -52,12 +61,16 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Both the registry and the returned vector are cached to speed up
       consecutive calls with the same registry.
     */
-    segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) {
+    EntryVector *get_entries(const StateRegistry *registry) {
         if (cached_registry != registry) {
             cached_registry = registry;
             auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
-                cached_entries = new segmented_vector::SegmentedVector<Entry>();
+                std::shared_ptr<segmented_vector::MappedSegmentPool> pool;
+                if (use_segment_pool)
+                    pool = registry->get_segment_pool();
+                cached_entries = new EntryVector(
+                    segmented_vector::SegmentAllocator<Entry>(pool));
                 entries_by_registry[registry] = cached_entries;
                 registry->subscribe(this);
             } else {
@@ -74,14 +87,14 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Otherwise, both the registry and the returned vector are cached to speed
       up consecutive calls with the same registry.
     */
-    const segmented_vector::SegmentedVector<Entry> *get_entries(const StateRegistry *registry) const {
+    const EntryVector *get_entries(const StateRegistry *registry) const {
         if (cached_registry != registry) {
             const auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
                 return nullptr;
             } else {
                 cached_registry = registry;
-                cached_entries = const_cast<segmented_vector::SegmentedVector<Entry> *>(it->second);
+                cached_entries = const_cast<EntryVector *>(it->second);
             }
         }
         assert(cached_registry == registry);
@@ -91,12 +104,15 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
 public:
     PerStateInformation()
         : default_value(),
+          use_segment_pool(false),
           cached_registry(nullptr),
           cached_entries(nullptr) {
     }
 
-    explicit PerStateInformation(const Entry &default_value_)
+    explicit PerStateInformation(const Entry &default_value_,
+                                 bool use_segment_pool = false)
         : default_value(default_value_),
+          use_segment_pool(use_segment_pool),
           cached_registry(nullptr),
           cached_entries(nullptr) {
     }
@@ -117,7 +133,7 @@ public:
                       << "unregistered state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
+        EntryVector *entries = get_entries(registry);
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
         size_t virtual_size = registry->size();
@@ -135,7 +151,7 @@ public:
                       << "unregistered state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        const segmented_vector::SegmentedVector<Entry> *entries = get_entries(registry);
+        const EntryVector *entries = get_entries(registry);
         if (!entries) {
             return default_value;
         }
@@ -5,6 +5,7 @@
 #include "option_parser.h"
 #include "plugin.h"
 
+#include "algorithms/mapped_segment_pool.h"
 #include "algorithms/ordered_set.h"
 #include "task_utils/successor_generator.h"
 #include "task_utils/task_properties.h"
@@ -15,6 +16,7 @@
 #include "utils/system.h"
 #include "utils/timer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <limits>
@@ -24,6 +26,18 @@ using utils::ExitCode;
 
 class PruningMethod;
 
+static shared_ptr<segmented_vector::MappedSegmentPool> create_segment_pool(
+    const Options &opts) {
+    if (!opts.contains("state_storage_dir"))
+        return nullptr;
+    string directory = opts.get<string>("state_storage_dir");
+    size_t resident_bytes =
+        static_cast<size_t>(opts.get<int>("state_storage_resident_memory")) << 20;
+    utils::g_log << "Storing states in a file in " << directory << endl;
+    return make_shared<segmented_vector::MappedSegmentPool>(
+        directory, resident_bytes);
+}
+
 successor_generator::SuccessorGenerator &get_successor_generator(const TaskProxy &task_proxy) {
     utils::g_log << "Building successor generator..." << flush;
     int peak_memory_before = utils::get_peak_memory_in_kb();
@@ -46,9 +60,9 @@ SearchEngine::SearchEngine(const Options &opts)
       solution_found(false),
       task(tasks::g_root_task),
       task_proxy(*task),
-      state_registry(task_proxy),
+      state_registry(task_proxy, create_segment_pool(opts)),
       successor_generator(get_successor_generator(task_proxy)),
-      search_space(state_registry),
+      search_space(state_registry, opts.get<OperatorCost>("cost_type")),
       search_progress(opts.get<utils::Verbosity>("verbosity")),
       statistics(opts.get<utils::Verbosity>("verbosity")),
       cost_type(opts.get<OperatorCost>("cost_type")),
@@ -99,6 +113,25 @@ void SearchEngine::search() {
     utils::g_log << "Actual search time: " << timer.get_elapsed_time() << endl;
 }
 
+void SearchEngine::collect_evaluators_for_statistics(
+    const EvaluationContext &eval_context) {
+    eval_context.get_cache().for_each_evaluator_result(
+        [this] (const Evaluator *eval, const EvaluationResult &) {
+            if (find(evaluators_with_statistics.begin(),
+                     evaluators_with_statistics.end(),
+                     eval) == evaluators_with_statistics.end()) {
+                evaluators_with_statistics.push_back(eval);
+            }
+        }
+        );
+}
+
+void SearchEngine::print_evaluator_statistics() const {
+    for (const Evaluator *eval : evaluators_with_statistics) {
+        eval->print_statistics();
+    }
+}
+
 bool SearchEngine::check_goal_and_set_plan(const State &state) {
     if (task_properties::is_goal_state(task_proxy, state)) {
         utils::g_log << "Solution found!" << endl;
@@ -149,6 +182,22 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    parser.add_option<string>(
+        "state_storage_dir",
+        "if given, the state data and the search node information are "
+        "stored in a temporary file in this directory (which should be on a "
+        "local disk) instead of on the heap. This lets the search continue "
+        "after the registered states exceed the physical memory, at the cost "
+        "of slower state lookups. It does not help with limits on the "
+        "address space of the process.",
+        OptionParser::NONE);
+    parser.add_option<int>(
+        "state_storage_resident_memory",
+        "amount of memory in MiB for the most recently stored states. If "
+        "state_storage_dir is set, older states are paged out first once "
+        "physical memory runs low.",
+        "1024",
+        Bounds("64", "infinity"));
     utils::add_verbosity_option_to_parser(parser);
 }
 
@@ -36,6 +36,7 @@ class SearchEngine {
     SearchStatus status;
     bool solution_found;
     Plan plan;
+    std::vector<const Evaluator *> evaluators_with_statistics;
 protected:
     // Hold a reference to the task implementation and pass it to objects that need it.
     const std::shared_ptr<AbstractTask> task;
@@ -57,6 +58,14 @@ protected:
     virtual void initialize() {}
     virtual SearchStatus step() = 0;
 
+    /*
+      Remember the evaluators evaluated in the given evaluation context
+      (usually the one of the initial state), so that
+      print_evaluator_statistics can print their statistics.
+    */
+    void collect_evaluators_for_statistics(const EvaluationContext &eval_context);
+    void print_evaluator_statistics() const;
+
     void set_plan(const Plan &plan);
     bool check_goal_and_set_plan(const State &state);
     int get_adjusted_cost(const OperatorProxy &op) const;
@@ -99,6 +99,8 @@ void EagerSearch::initialize() {
 
     print_initial_evaluator_values(eval_context);
 
+    collect_evaluators_for_statistics(eval_context);
+
     pruning_method->initialize(task);
 }
 
@@ -106,6 +108,7 @@ void EagerSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
     pruning_method->print_statistics();
+    print_evaluator_statistics();
 }
 
 SearchStatus EagerSearch::step() {
@@ -111,6 +111,7 @@ void EnforcedHillClimbingSearch::initialize() {
     bool dead_end = current_eval_context.is_evaluator_value_infinite(evaluator.get());
     statistics.inc_evaluated_states();
     print_initial_evaluator_values(current_eval_context);
+    collect_evaluators_for_statistics(current_eval_context);
 
     if (dead_end) {
         utils::g_log << "Initial state is a dead end, no solution" << endl;
@@ -265,6 +266,7 @@ void EnforcedHillClimbingSearch::print_statistics() const {
                      << " - Avg. Expansions: "
                      << static_cast<double>(total_expansions) / phases << endl;
     }
+    print_evaluator_statistics();
 }
 
 static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
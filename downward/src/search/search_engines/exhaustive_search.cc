@@ -114,6 +114,8 @@ void ExhaustiveSearch::initialize() {
 
     print_initial_evaluator_values(eval_context);
 
+    collect_evaluators_for_statistics(eval_context);
+
     pruning_method->initialize(task);
 }
 
@@ -121,6 +123,7 @@ void ExhaustiveSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
     pruning_method->print_statistics();
+    print_evaluator_statistics();
 }
 
 SearchStatus ExhaustiveSearch::step() {
@@ -203,6 +203,7 @@ SearchStatus LazySearch::step() {
         }
         if (current_predecessor_id == StateID::no_state) {
             print_initial_evaluator_values(current_eval_context);
+            collect_evaluators_for_statistics(current_eval_context);
         }
     }
     return fetch_next_state();
@@ -215,5 +216,6 @@ void LazySearch::reward_progress() {
 void LazySearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
+    print_evaluator_statistics();
 }
 }
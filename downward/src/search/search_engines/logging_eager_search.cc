@@ -107,6 +107,8 @@ void LoggingEagerSearch::initialize() {
 
     print_initial_evaluator_values(eval_context);
 
+    collect_evaluators_for_statistics(eval_context);
+
     pruning_method->initialize(task);
 }
 
@@ -114,6 +116,7 @@ void LoggingEagerSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
     pruning_method->print_statistics();
+    print_evaluator_statistics();
 }
 
 SearchStatus LoggingEagerSearch::step() {
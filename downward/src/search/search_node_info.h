@@ -7,6 +7,12 @@
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
+/*
+  We store one SearchNodeInfo per registered state, so it is kept at 12
+  bytes. The real g value (the g value with respect to the original
+  action costs) is not part of it: in most searches it equals g, and
+  otherwise the SearchSpace stores it separately (see search_space.h).
+*/
 struct SearchNodeInfo {
     enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
 
@@ -14,11 +20,10 @@ struct SearchNodeInfo {
     int g : 30;
     StateID parent_state_id;
     OperatorID creating_operator;
-    int real_g;
 
     SearchNodeInfo()
         : status(NEW), g(-1), parent_state_id(StateID::no_state),
-          creating_operator(-1), real_g(-1) {
+          creating_operator(-1) {
     }
 };
 
@@ -10,11 +10,16 @@
 
 using namespace std;
 
-SearchNode::SearchNode(const State &state, SearchNodeInfo &info)
-    : state(state), info(info) {
+SearchNode::SearchNode(const State &state, SearchNodeInfo &info, int *real_g)
+    : state(state), info(info), real_g(real_g) {
     assert(state.get_id() != StateID::no_state);
 }
 
+void SearchNode::set_real_g(int value) {
+    if (real_g)
+        *real_g = value;
+}
+
 const State &SearchNode::get_state() const {
     return state;
 }
@@ -41,14 +46,16 @@ int SearchNode::get_g() const {
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    if (real_g)
+        return *real_g;
+    return info.g;
 }
 
 void SearchNode::open_initial() {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = 0;
-    info.real_g = 0;
+    set_real_g(0);
     info.parent_state_id = StateID::no_state;
     info.creating_operator = OperatorID::no_operator;
 }
@@ -59,7 +66,7 @@ void SearchNode::open(const SearchNode &parent_node,
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
+    set_real_g(parent_node.get_real_g() + parent_op.get_cost());
     info.parent_state_id = parent_node.get_state().get_id();
     info.creating_operator = OperatorID(parent_op.get_id());
 }
@@ -74,7 +81,7 @@ void SearchNode::reopen(const SearchNode &parent_node,
     // may require reopening closed nodes.
     info.status = SearchNodeInfo::OPEN;
     info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
+    set_real_g(parent_node.get_real_g() + parent_op.get_cost());
     info.parent_state_id = parent_node.get_state().get_id();
     info.creating_operator = OperatorID(parent_op.get_id());
 }
@@ -88,7 +95,7 @@ void SearchNode::update_parent(const SearchNode &parent_node,
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
     info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
+    set_real_g(parent_node.get_real_g() + parent_op.get_cost());
     info.parent_state_id = parent_node.get_state().get_id();
     info.creating_operator = OperatorID(parent_op.get_id());
 }
@@ -115,12 +122,17 @@ void SearchNode::dump(const TaskProxy &task_proxy) const {
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry)
-    : state_registry(state_registry) {
+SearchSpace::SearchSpace(StateRegistry &state_registry, OperatorCost cost_type)
+    : search_node_infos(SearchNodeInfo(), true),
+      store_real_g(cost_type != NORMAL &&
+                   !task_properties::is_unit_cost(state_registry.get_task_proxy())),
+      real_g_values(-1, true),
+      state_registry(state_registry) {
 }
 
 SearchNode SearchSpace::get_node(const State &state) {
-    return SearchNode(state, search_node_infos[state]);
+    int *real_g = store_real_g ? &real_g_values[state] : nullptr;
+    return SearchNode(state, search_node_infos[state], real_g);
 }
 
 void SearchSpace::trace_path(const State &goal_state,
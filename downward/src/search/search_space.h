@@ -15,8 +15,12 @@ class TaskProxy;
 class SearchNode {
     State state;
     SearchNodeInfo &info;
+    // Points to the real g value if it is stored separately from g.
+    int *real_g;
+
+    void set_real_g(int value);
 public:
-    SearchNode(const State &state, SearchNodeInfo &info);
+    SearchNode(const State &state, SearchNodeInfo &info, int *real_g);
 
     const State &get_state() const;
 
@@ -45,12 +49,24 @@ public:
 };
 
 
+/*
+  The real g value of a node only differs from its g value if the
+  search uses adjusted action costs (cost_type != NORMAL) on a task that
+  does not have unit costs. Only in this case, we store the real g
+  values in a separate PerStateInformation, which costs 4 bytes per
+  registered state.
+
+  The node infos (and real g values) are stored in the segment pool of
+  the state registry if it has one.
+*/
 class SearchSpace {
     PerStateInformation<SearchNodeInfo> search_node_infos;
+    const bool store_real_g;
+    PerStateInformation<int> real_g_values;
 
     StateRegistry &state_registry;
 public:
-    explicit SearchSpace(StateRegistry &state_registry);
+    SearchSpace(StateRegistry &state_registry, OperatorCost cost_type);
 
     SearchNode get_node(const State &state);
     void trace_path(const State &goal_state,
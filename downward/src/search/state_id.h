@@ -1,11 +1,18 @@
 #ifndef STATE_ID_H
 #define STATE_ID_H
 
+#include "utils/hash.h"
+
 #include <iostream>
 
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
+namespace open_list_trace {
+class Trace;
+class TraceWriter;
+}
+
 class StateID {
     friend class StateRegistry;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
@@ -14,6 +21,8 @@ class StateID {
     template<typename>
     friend class PerStateArray;
     friend class PerStateBitset;
+    friend class open_list_trace::Trace;
+    friend class open_list_trace::TraceWriter;
 
     int value;
     explicit StateID(int value_)
@@ -35,7 +44,17 @@ public:
     bool operator!=(const StateID &other) const {
         return !(*this == other);
     }
+
+    int hash() const {
+        return value;
+    }
 };
 
+namespace utils {
+inline void feed(HashState &hash_state, StateID id) {
+    feed(hash_state, id.hash());
+}
+}
+
 
 #endif
@@ -8,12 +8,17 @@
 
 using namespace std;
 
-StateRegistry::StateRegistry(const TaskProxy &task_proxy)
+StateRegistry::StateRegistry(
+    const TaskProxy &task_proxy,
+    const shared_ptr<segmented_vector::MappedSegmentPool> &segment_pool)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
       num_variables(task_proxy.get_variables().size()),
-      state_data_pool(get_bins_per_state()),
+      segment_pool(segment_pool),
+      state_data_pool(
+          get_bins_per_state(),
+          segmented_vector::SegmentAllocator<PackedStateBin>(segment_pool)),
       registered_states(
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state())) {
@@ -106,4 +111,8 @@ int StateRegistry::get_state_size_in_bytes() const {
 void StateRegistry::print_statistics() const {
     utils::g_log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics();
+    if (segment_pool) {
+        utils::g_log << "Segment file size: "
+                     << segment_pool->get_file_size() / 1024 << " KB" << endl;
+    }
 }
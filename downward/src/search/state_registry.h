@@ -7,6 +7,7 @@
 
 #include "algorithms/int_hash_set.h"
 #include "algorithms/int_packer.h"
+#include "algorithms/mapped_segment_pool.h"
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
 #include "utils/hash.h"
@@ -58,13 +59,16 @@
     This class is used to store the actual (packed) state data for all states
     while avoiding dynamically allocating each state individually.
     The index within this vector corresponds to the ID of the state.
+    Optionally, its segments are stored in a file (see MappedSegmentPool),
+    so that more states than fit into memory can be registered.
 
   PerStateInformation<T>
     Associates a value of type T with every state in a given StateRegistry.
     Can be thought of as a very compactly implemented map from State to T.
     References stay valid as long as the state registry exists. Memory usage is
     essentially the same as a vector<T> whose size is the number of states in
-    the registry.
+    the registry. PerStateInformation objects can opt into storing their
+    data in the segment pool of the registry (if it has one).
 
 
   ---------------
@@ -110,14 +114,16 @@ class IntPacker;
 }
 
 using PackedStateBin = int_packer::IntPacker::Bin;
+using StateDataPool = segmented_vector::SegmentedArrayVector<
+    PackedStateBin, segmented_vector::SegmentAllocator<PackedStateBin>>;
 
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
@@ -134,10 +140,10 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
@@ -162,7 +168,8 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    std::shared_ptr<segmented_vector::MappedSegmentPool> segment_pool;
+    StateDataPool state_data_pool;
     StateIDSet registered_states;
 
     std::unique_ptr<State> cached_initial_state;
@@ -170,7 +177,13 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     StateID insert_id_or_pop_state();
     int get_bins_per_state() const;
 public:
-    explicit StateRegistry(const TaskProxy &task_proxy);
+    /*
+      If segment_pool is given, the state data is stored in its file
+      instead of on the heap.
+    */
+    explicit StateRegistry(
+        const TaskProxy &task_proxy,
+        const std::shared_ptr<segmented_vector::MappedSegmentPool> &segment_pool = nullptr);
 
     const TaskProxy &get_task_proxy() const {
         return task_proxy;
@@ -184,6 +197,11 @@ public:
         return state_packer;
     }
 
+    // Returns nullptr if the registry keeps all data on the heap.
+    const std::shared_ptr<segmented_vector::MappedSegmentPool> &get_segment_pool() const {
+        return segment_pool;
+    }
+
     /*
       Returns the state that was registered at the given ID. The ID must refer
       to a state in this registry. Do not mix IDs from from different registries.
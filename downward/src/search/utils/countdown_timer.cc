@@ -28,4 +28,24 @@ Duration CountdownTimer::get_elapsed_time() const {
 Duration CountdownTimer::get_remaining_time() const {
     return Duration(max_time - get_elapsed_time());
 }
+
+WallClockCountdownTimer::WallClockCountdownTimer(double max_time)
+    : max_time(max_time) {
+}
+
+void WallClockCountdownTimer::reset() {
+    timer.reset();
+}
+
+bool WallClockCountdownTimer::is_expired() const {
+    return max_time != numeric_limits<double>::infinity() && timer() >= max_time;
+}
+
+Duration WallClockCountdownTimer::get_elapsed_time() const {
+    return timer();
+}
+
+Duration WallClockCountdownTimer::get_remaining_time() const {
+    return Duration(max_time - get_elapsed_time());
+}
 }
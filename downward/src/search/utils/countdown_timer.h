@@ -14,6 +14,22 @@ public:
     Duration get_elapsed_time() const;
     Duration get_remaining_time() const;
 };
+
+/*
+  Like CountdownTimer, but counts down elapsed real time instead of the
+  CPU time of the process, which is summed over all threads.
+*/
+class WallClockCountdownTimer {
+    WallClockTimer timer;
+    double max_time;
+public:
+    explicit WallClockCountdownTimer(double max_time);
+    // Restart the countdown with the full time.
+    void reset();
+    bool is_expired() const;
+    Duration get_elapsed_time() const;
+    Duration get_remaining_time() const;
+};
 }
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef UTILS_HASH_H
 #define UTILS_HASH_H
 
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -258,6 +259,17 @@ void feed(HashState &hash_state, const std::vector<T> &vec) {
     }
 }
 
+template<typename T, std::size_t N>
+void feed(HashState &hash_state, const std::array<T, N> &arr) {
+    /*
+      Unlike vectors, arrays of different lengths have different types, so
+      we do not need to feed the length.
+    */
+    for (const T &item : arr) {
+        feed(hash_state, item);
+    }
+}
+
 
 /*
   Public hash functions.
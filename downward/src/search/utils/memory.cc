@@ -2,34 +2,54 @@
 
 #include "../utils/logging.h"
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
 namespace utils {
-static char *extra_memory_padding = nullptr;
+static atomic<char *> extra_memory_padding(nullptr);
+/*
+  Several threads may run out of memory at the same time. The mutex
+  ensures that only one of them releases the padding and writes to the
+  log.
+*/
+static mutex extra_memory_padding_mutex;
 
 // Save standard out-of-memory handler.
 static void (*standard_out_of_memory_handler)() = nullptr;
 
+static void release_extra_memory_padding_locked() {
+    assert(extra_memory_padding);
+    delete[] extra_memory_padding.exchange(nullptr);
+    assert(standard_out_of_memory_handler);
+    set_new_handler(standard_out_of_memory_handler);
+}
+
 void continuing_out_of_memory_handler() {
-    release_extra_memory_padding();
-    utils::g_log << "Failed to allocate memory. Released extra memory padding." << endl;
+    lock_guard<mutex> lock(extra_memory_padding_mutex);
+    /*
+      If another thread already released the padding, we return, so the
+      allocation is retried with the memory that has become available.
+    */
+    if (extra_memory_padding) {
+        release_extra_memory_padding_locked();
+        utils::g_log << "Failed to allocate memory. Released extra memory padding." << endl;
+    }
 }
 
 void reserve_extra_memory_padding(int memory_in_mb) {
+    lock_guard<mutex> lock(extra_memory_padding_mutex);
     assert(!extra_memory_padding);
     extra_memory_padding = new char[memory_in_mb * 1024 * 1024];
     standard_out_of_memory_handler = set_new_handler(continuing_out_of_memory_handler);
 }
 
 void release_extra_memory_padding() {
-    assert(extra_memory_padding);
-    delete[] extra_memory_padding;
-    extra_memory_padding = nullptr;
-    assert(standard_out_of_memory_handler);
-    set_new_handler(standard_out_of_memory_handler);
+    lock_guard<mutex> lock(extra_memory_padding_mutex);
+    release_extra_memory_padding_locked();
 }
 
 bool extra_memory_padding_is_reserved() {
@@ -24,6 +24,8 @@ std::unique_ptr<T> make_unique_ptr(Args && ... args) {
 
   The interface assumes a single user. It is not possible for two parts
   of the planner to reserve extra memory padding at the same time.
+  However, several threads of that user may run out of memory
+  concurrently; the padding is then released only once.
 */
 extern void reserve_extra_memory_padding(int memory_in_mb);
 extern void release_extra_memory_padding();
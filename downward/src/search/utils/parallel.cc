@@ -0,0 +1,57 @@
+#include "parallel.h"
+
+#include "../options/option_parser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace utils {
+void parallel_for(
+    int num_items, int num_threads,
+    const function<void(int item, int thread_index)> &callback) {
+    num_threads = min(num_threads, num_items);
+    if (num_threads <= 1) {
+        for (int item = 0; item < num_items; ++item) {
+            callback(item, 0);
+        }
+        return;
+    }
+
+    atomic<int> next_item(0);
+    auto worker = [&](int thread_index) {
+            while (true) {
+                int item = next_item++;
+                if (item >= num_items)
+                    break;
+                callback(item, thread_index);
+            }
+        };
+    vector<thread> threads;
+    threads.reserve(num_threads - 1);
+    for (int thread_index = 1; thread_index < num_threads; ++thread_index) {
+        threads.emplace_back(worker, thread_index);
+    }
+    worker(0);
+    for (thread &t : threads) {
+        t.join();
+    }
+}
+
+int get_num_hardware_threads() {
+    return max(1u, thread::hardware_concurrency());
+}
+
+void add_threads_option_to_parser(
+    options::OptionParser &parser, const string &usage) {
+    parser.add_option<int>(
+        "threads",
+        usage + ". Note that every thread reserves additional address "
+        "space, which counts towards memory limits set with ulimit -v.",
+        "1",
+        options::Bounds("1", "infinity"));
+}
+}
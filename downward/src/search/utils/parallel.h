@@ -0,0 +1,45 @@
+#ifndef UTILS_PARALLEL_H
+#define UTILS_PARALLEL_H
+
+#include <functional>
+#include <string>
+
+namespace options {
+class OptionParser;
+}
+
+namespace utils {
+/*
+  Call callback(item, thread_index) for all items in [0, num_items) on
+  num_threads threads (including the calling thread). Items are handed
+  out to the threads dynamically, so callers must not rely on the order
+  in which items are processed or on the assignment of items to threads.
+  Callers get deterministic results by letting each item write to its
+  own slot of a result vector and by giving each thread its own scratch
+  data (indexed by thread_index). The function returns when all items
+  have been processed.
+
+  With num_threads <= 1, the items are processed in order on the calling
+  thread without starting any threads.
+
+  Note that most of the planner is not thread-safe. In particular,
+  callbacks must not write to utils::g_log or use the global random
+  number generator.
+*/
+extern void parallel_for(
+    int num_items, int num_threads,
+    const std::function<void(int item, int thread_index)> &callback);
+
+// Number of threads supported by the hardware (at least 1).
+extern int get_num_hardware_threads();
+
+/*
+  Add the option "threads" (default: 1) to parser. The help text starts
+  with usage, which should say what the threads compute and whether the
+  result depends on their number.
+*/
+extern void add_threads_option_to_parser(
+    options::OptionParser &parser, const std::string &usage);
+}
+
+#endif
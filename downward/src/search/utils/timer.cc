@@ -112,5 +112,48 @@ ostream &operator<<(ostream &os, const Timer &timer) {
     return os;
 }
 
+WallClockTimer::WallClockTimer(bool start)
+    : last_start(chrono::steady_clock::now()),
+      collected_time(0),
+      stopped(!start) {
+}
+
+double WallClockTimer::get_time_since_last_start() const {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - last_start;
+    return elapsed.count();
+}
+
+Duration WallClockTimer::stop() {
+    collected_time = (*this)();
+    stopped = true;
+    return Duration(collected_time);
+}
+
+Duration WallClockTimer::operator()() const {
+    if (stopped)
+        return Duration(collected_time);
+    else
+        return Duration(collected_time + get_time_since_last_start());
+}
+
+void WallClockTimer::resume() {
+    if (stopped) {
+        stopped = false;
+        last_start = chrono::steady_clock::now();
+    }
+}
+
+Duration WallClockTimer::reset() {
+    double result = (*this)();
+    collected_time = 0;
+    last_start = chrono::steady_clock::now();
+    return Duration(result);
+}
+
+ostream &operator<<(ostream &os, const WallClockTimer &timer) {
+    os << timer();
+    return os;
+}
+
 Timer g_timer;
 }
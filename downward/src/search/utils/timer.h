@@ -3,6 +3,7 @@
 
 #include "system.h"
 
+#include <chrono>
 #include <ostream>
 
 namespace utils {
@@ -38,6 +39,26 @@ public:
 
 std::ostream &operator<<(std::ostream &os, const Timer &timer);
 
+/*
+  Like Timer, but measures elapsed real time instead of the CPU time of
+  the process, which is summed over all threads.
+*/
+class WallClockTimer {
+    std::chrono::steady_clock::time_point last_start;
+    double collected_time;
+    bool stopped;
+
+    double get_time_since_last_start() const;
+public:
+    explicit WallClockTimer(bool start = true);
+    Duration operator()() const;
+    Duration stop();
+    void resume();
+    Duration reset();
+};
+
+std::ostream &operator<<(std::ostream &os, const WallClockTimer &timer);
+
 extern Timer g_timer;
 }
 